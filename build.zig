@@ -323,6 +323,7 @@ pub fn build(b: *std.Build) !void {
         .HAVE__NSGETENVIRON = is_darwin,
         .HAVE_FD_CLOEXEC = modern_unix,
         .HAVE_FSEEKO = modern_unix,
+        .HAVE_POSIX_FADVISE = modern_unix and !is_darwin,
         .HAVE_LANGINFO_H = modern_unix,
         .HAVE_NL_LANGINFO_CODESET = modern_unix,
         .HAVE_NL_MSG_CAT_CNTR = t.isGnuLibC(),
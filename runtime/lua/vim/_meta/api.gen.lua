@@ -163,6 +163,23 @@ function vim.api.nvim__ns_set(ns_id, opts) end
 --- - winbar: Redraw the 'winbar' in `buf`, `win` or all windows.
 function vim.api.nvim__redraw(opts) end
 
+--- WARNING: This feature is experimental/unstable.
+---
+--- Gets the cost of matching each regexp pattern, for finding patterns that
+--- use much CPU time. Counting is off by default, only patterns compiled
+--- while it is enabled are counted.
+---
+--- @param opts vim.api.keyset.regexp_stats? Optional parameters.
+--- - enable: Start (true) or stop (false) counting.
+--- - clear: Reset the counters after getting them.
+--- @return table<string,any> # Dict mapping each pattern that was matched to a Dict with:
+--- - "calls"     number of times it was matched
+--- - "time"      nanoseconds spent matching
+--- - "steps"     NFA states or backtracking items visited
+--- - "switches"  times the NFA engine switched to the backtracking engine
+--- - "timeouts"  times matching stopped at the time limit
+function vim.api.nvim__regexp_stats(opts) end
+
 --- WARNING: This feature is experimental/unstable.
 ---
 --- @return any[]
@@ -183,6 +200,10 @@ function vim.api.nvim__set_restart_on_crash(progpath, argv) end
 ---
 --- Gets internal stats.
 ---
+--- "events_queued_max" and "events_wait_max" (nanoseconds) are the most events
+--- queued on the main loop and the longest time one waited, since the previous
+--- call.
+---
 --- @return table<string,any> # Map of various internal stats.
 function vim.api.nvim__stats() end
 
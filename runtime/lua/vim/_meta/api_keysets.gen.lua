@@ -405,6 +405,10 @@ error('Cannot require a meta file')
 --- @field win? integer
 --- @field winbar? boolean
 
+--- @class vim.api.keyset.regexp_stats
+--- @field clear? boolean
+--- @field enable? boolean
+
 --- @class vim.api.keyset.runtime
 --- @field do_source? boolean
 --- @field is_lua? boolean
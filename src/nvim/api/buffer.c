@@ -354,14 +354,15 @@ void nvim_buf_set_lines(uint64_t channel_id, Buffer buf, Integer start, Integer
   size_t old_len = (size_t)(end - start);
   ptrdiff_t extra = 0;  // lines added to text, can be negative
   char **lines = (new_len != 0) ? arena_alloc(arena, new_len * sizeof(char *), true) : NULL;
+  // Lengths of the lines, so that they don't have to be computed again for
+  // every line that is replaced or appended.
+  size_t *lens = (new_len != 0) ? arena_alloc(arena, new_len * sizeof(size_t), true) : NULL;
 
   for (size_t i = 0; i < new_len; i++) {
     const String l = replacement.items[i].data.string;
 
-    // Fill lines[i] with l's contents. Convert NULs to newlines as required by
-    // NL-used-for-NUL.
-    lines[i] = arena_memdupz(arena, l.data, l.size);
-    memchrsub(lines[i], NUL, NL, l.size);
+    lines[i] = replacement_line(channel_id, l, arena);
+    lens[i] = l.size;
   }
 
   TRY_WRAP(err, {
@@ -404,12 +405,12 @@ void nvim_buf_set_lines(uint64_t channel_id, Buffer buf, Integer start, Integer
         goto end;
       });
 
-      if (ml_replace_buf(b, (linenr_T)lnum, lines[i], false, true) == FAIL) {
+      if (ml_replace_buf_len(b, (linenr_T)lnum, lines[i], lens[i], false, true) == FAIL) {
         api_set_error(err, kErrorTypeException, "Failed to replace line");
         goto end;
       }
 
-      inserted_bytes += (bcount_t)strlen(lines[i]) + 1;
+      inserted_bytes += (bcount_t)lens[i] + 1;
     }
 
     // Now we may need to insert the remaining new old_len
@@ -420,12 +421,12 @@ void nvim_buf_set_lines(uint64_t channel_id, Buffer buf, Integer start, Integer
         goto end;
       });
 
-      if (ml_append_buf(b, (linenr_T)lnum, lines[i], 0, false) == FAIL) {
+      if (ml_append_buf(b, (linenr_T)lnum, lines[i], (colnr_T)lens[i] + 1, false) == FAIL) {
         api_set_error(err, kErrorTypeException, "Failed to insert line");
         goto end;
       }
 
-      inserted_bytes += (bcount_t)strlen(lines[i]) + 1;
+      inserted_bytes += (bcount_t)lens[i] + 1;
 
       extra++;
     }
@@ -585,10 +586,7 @@ void nvim_buf_set_text(uint64_t channel_id, Buffer buf, Integer start_row, Integ
   for (size_t i = 1; i < new_len - 1; i++) {
     const String l = replacement.items[i].data.string;
 
-    // Fill lines[i] with l's contents. Convert NULs to newlines as required by
-    // NL-used-for-NUL.
-    lines[i] = arena_memdupz(arena, l.data, l.size);
-    memchrsub(lines[i], NUL, NL, l.size);
+    lines[i] = replacement_line(channel_id, l, arena);
     new_byte += (bcount_t)(l.size) + 1;
   }
   if (replacement.size > 1) {
@@ -1251,7 +1249,7 @@ Dict nvim__buf_stats(Buffer buf, Arena *arena, Error *err)
     return (Dict)ARRAY_DICT_INIT;
   }
 
-  Dict rv = arena_dict(arena, 7);
+  Dict rv = arena_dict(arena, 9);
   // Number of times the cached line was flushed.
   // This should generally not increase while editing the same
   // line in the same mode.
@@ -1265,6 +1263,9 @@ Dict nvim__buf_stats(Buffer buf, Arena *arena, Error *err)
   PUT_C(rv, "dirty_bytes", INTEGER_OBJ((Integer)b->deleted_bytes));
   PUT_C(rv, "dirty_bytes2", INTEGER_OBJ((Integer)b->deleted_bytes2));
   PUT_C(rv, "virt_blocks", INTEGER_OBJ((Integer)buf_meta_total(b, kMTMetaLines)));
+  // memory used by the undo tree and its number of undo headers
+  PUT_C(rv, "undo_bytes", INTEGER_OBJ((Integer)u_mem_used(b)));
+  PUT_C(rv, "undo_headers", INTEGER_OBJ((Integer)b->b_u_numhead));
 
   u_header_T *uhp = NULL;
   if (b->b_u_curhead != NULL) {
@@ -1279,6 +1280,23 @@ Dict nvim__buf_stats(Buffer buf, Arena *arena, Error *err)
   return rv;
 }
 
+/// Gets the text of a replacement line for nvim_buf_set_lines() or nvim_buf_set_text().
+///
+/// NULs are converted to newlines as required by NL-used-for-NUL. Strings decoded
+/// from a channel or popped from Lua are already NUL-terminated in the arena and
+/// are used as-is when they contain no NUL, the lines are copied into the memline
+/// anyway.
+static char *replacement_line(uint64_t channel_id, String l, Arena *arena)
+{
+  if ((channel_id == LUA_INTERNAL_CALL || (channel_id != 0 && !is_internal_call(channel_id)))
+      && l.data != NULL && memchr(l.data, NUL, l.size) == NULL) {
+    return l.data;
+  }
+  char *line = arena_memdupz(arena, l.data, l.size);
+  memchrsub(line, NUL, NL, l.size);
+  return line;
+}
+
 // Check if deleting lines made the cursor position invalid.
 // Changed lines from `lo` to `hi`; added `extra` lines (negative if deleted).
 static void fix_cursor(win_T *win, linenr_T lo, linenr_T hi, linenr_T extra)
@@ -463,6 +463,12 @@ typedef struct {
   Buffer buf;
 } Dict(redraw);
 
+typedef struct {
+  OptionalKeys is_set__regexp_stats_;
+  Boolean enable;
+  Boolean clear;
+} Dict(regexp_stats);
+
 typedef struct {
   OptionalKeys is_set__ns_opts_;
   Array wins;
@@ -53,6 +53,20 @@
 // TODO(bfredl): just make UI:s owned by their channels instead
 static PMap(uint64_t) connected_uis = MAP_INIT;
 
+/// The last "grid_line" call encoded by remote_ui_raw_line(). When several UIs
+/// are attached, the next UI drawing the same line copies it instead of
+/// encoding the cells again.
+static struct {
+  bool valid;
+  Integer grid, row, startcol, endcol, clearcol, clearattr;
+  LineFlags flags;
+  const schar_T *chunk;
+  const sattr_T *attrs;
+  size_t ncells;  ///< added to ncells_pending
+  size_t len;
+  char data[UI_BUF_SIZE];
+} line_cache;
+
 /// Gets the UI attached to the given channel, or sets an error message on `err`.
 static RemoteUI *get_ui_or_err(uint64_t chan_id, Error *err)
 {
@@ -826,6 +840,21 @@ void remote_ui_raw_line(RemoteUI *ui, Integer grid, Integer row, Integer startco
     prepare_call(ui, "grid_line");
 
     char **buf = &ui->packer.ptr;
+    if (line_cache.valid && line_cache.grid == grid && line_cache.row == row
+        && line_cache.startcol == startcol && line_cache.endcol == endcol
+        && line_cache.clearcol == clearcol && line_cache.clearattr == clearattr
+        && line_cache.flags == flags && line_cache.chunk == chunk && line_cache.attrs == attrs
+        && line_cache.len <= UI_BUF_SIZE - BUF_POS(ui)
+        && ui->ncells_pending + line_cache.ncells < 500) {
+      memcpy(*buf, line_cache.data, line_cache.len);
+      *buf += line_cache.len;
+      ui->ncells_pending += line_cache.ncells;
+      return;
+    }
+
+    char *line_start = *buf;
+    size_t ncells_start = ui->ncells_pending;
+    bool split = false;
     mpack_array(buf, 5);
     mpack_uint(buf, (uint32_t)grid);
     mpack_uint(buf, (uint32_t)row);
@@ -863,6 +892,7 @@ void remote_ui_raw_line(RemoteUI *ui, Integer grid, Integer row, Integer startco
           // We only ever set the wrap field on the final "grid_line" event for the line.
           mpack_bool(buf, false);
           ui_flush_buf(ui, false);
+          split = true;
 
           prepare_call(ui, "grid_line");
           mpack_array(buf, 5);
@@ -903,6 +933,22 @@ void remote_ui_raw_line(RemoteUI *ui, Integer grid, Integer row, Integer startco
     }
     mpack_w2(&lenpos, nelem);
     mpack_bool(buf, flags & kLineFlagWrap);
+
+    line_cache.valid = !split && map_size(&connected_uis) > 1;
+    if (line_cache.valid) {
+      line_cache.grid = grid;
+      line_cache.row = row;
+      line_cache.startcol = startcol;
+      line_cache.endcol = endcol;
+      line_cache.clearcol = clearcol;
+      line_cache.clearattr = clearattr;
+      line_cache.flags = flags;
+      line_cache.chunk = chunk;
+      line_cache.attrs = attrs;
+      line_cache.ncells = ui->ncells_pending - ncells_start;
+      line_cache.len = (size_t)(*buf - line_start);
+      memcpy(line_cache.data, line_start, line_cache.len);
+    }
   } else {
     for (int i = 0; i < endcol - startcol; i++) {
       remote_ui_cursor_goto(ui, row, startcol + i);
@@ -992,6 +1038,13 @@ void remote_ui_flush_pending_data(RemoteUI *ui)
   ui_flush_buf(ui, false);
 }
 
+/// Forgets the line encoded by remote_ui_raw_line(). Must be called before
+/// each raw_line event, as the cells of the previous one may have changed.
+void remote_ui_line_cache_clear(void)
+{
+  line_cache.valid = false;
+}
+
 static Array translate_contents(RemoteUI *ui, Array contents, Arena *arena)
 {
   Array new_contents = arena_array(arena, contents.size);
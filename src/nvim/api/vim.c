@@ -35,6 +35,7 @@
 #include "nvim/eval/typval.h"
 #include "nvim/eval/typval_defs.h"
 #include "nvim/eval/vars.h"
+#include "nvim/event/multiqueue.h"
 #include "nvim/ex_docmd.h"
 #include "nvim/ex_eval.h"
 #include "nvim/fold.h"
@@ -53,11 +54,13 @@
 #include "nvim/lua/executor.h"
 #include "nvim/lua/treesitter.h"
 #include "nvim/macros_defs.h"
+#include "nvim/main.h"
 #include "nvim/mapping.h"
 #include "nvim/mark.h"
 #include "nvim/mark_defs.h"
 #include "nvim/math.h"
 #include "nvim/mbyte.h"
+#include "nvim/memfile.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
 #include "nvim/memory_defs.h"
@@ -77,6 +80,8 @@
 #include "nvim/os/proc.h"
 #include "nvim/popupmenu.h"
 #include "nvim/pos_defs.h"
+#include "nvim/regexp.h"
+#include "nvim/regexp_defs.h"
 #include "nvim/register.h"
 #include "nvim/runtime.h"
 #include "nvim/sign_defs.h"
@@ -1902,16 +1907,75 @@ Float nvim__id_float(Float flt)
 
 /// Gets internal stats.
 ///
+/// "events_queued_max" and "events_wait_max" (nanoseconds) are the most events
+/// queued on the main loop and the longest time one waited, since the previous
+/// call.
+///
 /// @return Map of various internal stats.
 Dict nvim__stats(Arena *arena)
 {
-  Dict rv = arena_dict(arena, 6);
+  Dict rv = arena_dict(arena, 13);
   PUT_C(rv, "fsync", INTEGER_OBJ(g_stats.fsync));
   PUT_C(rv, "log_skip", INTEGER_OBJ(g_stats.log_skip));
   PUT_C(rv, "lua_refcount", INTEGER_OBJ(nlua_get_global_ref_count()));
   PUT_C(rv, "redraw", INTEGER_OBJ(g_stats.redraw));
   PUT_C(rv, "arena_alloc_count", INTEGER_OBJ((Integer)arena_alloc_count));
   PUT_C(rv, "ts_query_parse_count", INTEGER_OBJ((Integer)tslua_query_parse_count));
+  PUT_C(rv, "memfile_bytes", INTEGER_OBJ((Integer)mf_mem_used()));
+  PUT_C(rv, "memfile_released", INTEGER_OBJ(g_stats.mf_released));
+  PUT_C(rv, "regexp_cache_hit", INTEGER_OBJ(g_stats.regexp_cache_hit));
+  PUT_C(rv, "regexp_cache_miss", INTEGER_OBJ(g_stats.regexp_cache_miss));
+  size_t depth, max_depth;
+  uint64_t max_wait;
+  multiqueue_stats(main_loop.events, &depth, &max_depth, &max_wait);
+  PUT_C(rv, "events_queued", INTEGER_OBJ((Integer)depth));
+  PUT_C(rv, "events_queued_max", INTEGER_OBJ((Integer)max_depth));
+  PUT_C(rv, "events_wait_max", INTEGER_OBJ((Integer)max_wait));
+  return rv;
+}
+
+/// Gets the cost of matching each regexp pattern, for finding patterns that
+/// use much CPU time.  Counting is off by default, only patterns compiled
+/// while it is enabled are counted.
+///
+/// @param opts  Optional parameters.
+///               - enable: Start (true) or stop (false) counting.
+///               - clear: Reset the counters after getting them.
+/// @return Dict mapping each pattern that was matched to a Dict with:
+///   - "calls"     number of times it was matched
+///   - "time"      nanoseconds spent matching
+///   - "steps"     NFA states or backtracking items visited
+///   - "switches"  times the NFA engine switched to the backtracking engine
+///   - "timeouts"  times matching stopped at the time limit
+Dict nvim__regexp_stats(Dict(regexp_stats) *opts, Arena *arena)
+{
+  size_t count = 0;
+  size_t iter = 0;
+  const char *pattern;
+  const RegexpStats *stats;
+  while (regexp_stats_iter(&iter, &pattern, &stats)) {
+    count++;
+  }
+
+  Dict rv = arena_dict(arena, count);
+  iter = 0;
+  while (regexp_stats_iter(&iter, &pattern, &stats)) {
+    Dict d = arena_dict(arena, 5);
+    PUT_C(d, "calls", INTEGER_OBJ(stats->calls));
+    PUT_C(d, "time", INTEGER_OBJ((Integer)stats->time));
+    PUT_C(d, "steps", INTEGER_OBJ(stats->steps));
+    PUT_C(d, "switches", INTEGER_OBJ(stats->switches));
+    PUT_C(d, "timeouts", INTEGER_OBJ(stats->timeouts));
+    kv_push_c(rv, ((KeyValuePair) { .key = arena_string(arena, cstr_as_string(pattern)),
+                                    .value = DICT_OBJ(d) }));
+  }
+
+  if (HAS_KEY(opts, regexp_stats, clear) && opts->clear) {
+    regexp_stats_clear();
+  }
+  if (HAS_KEY(opts, regexp_stats, enable)) {
+    regexp_profile_set(opts->enable);
+  }
   return rv;
 }
 
@@ -1452,23 +1452,32 @@ restore_backup:
     fileformat = get_fileformat_force(buf, eap);
     char *s = buffer;
     for (lnum = start; lnum <= end; lnum++) {
-      // The next while loop is done once for each character written.
-      // Keep it fast!
-      char *ptr = ml_get_buf(buf, lnum) - 1;
+      char *ptr = ml_get_buf(buf, lnum);
+      char *const line_end = ptr + ml_get_buf_len(buf, lnum);
       if (write_undo_file) {
-        sha256_update(&sha_ctx, (uint8_t *)ptr + 1, (uint32_t)(strlen(ptr + 1) + 1));
+        sha256_update(&sha_ctx, (uint8_t *)ptr, (uint32_t)(line_end - ptr + 1));
       }
-      char c;
-      while ((c = *++ptr) != NUL) {
-        if (c == NL) {
-          *s = NUL;                       // replace newlines with NULs
-        } else if (c == CAR && fileformat == EOL_MAC) {
-          *s = NL;                        // Mac: replace CRs with NLs
-        } else {
-          *s = c;
+      // The next while loop is done once for each part of a line that fits
+      // in the buffer.  The text is copied as a whole and then the few
+      // special characters are replaced.  Keep it fast!
+      while (ptr < line_end) {
+        int n = MIN((int)(line_end - ptr), bufsize - write_info.bw_len);
+        char *const s_end = s + n;
+        memcpy(s, ptr, (size_t)n);
+        // replace newlines with NULs
+        for (char *q = s; (q = memchr(q, NL, (size_t)(s_end - q))) != NULL; q++) {
+          *q = NUL;
+        }
+        if (fileformat == EOL_MAC) {
+          // Mac: replace CRs with NLs
+          for (char *q = s; (q = memchr(q, CAR, (size_t)(s_end - q))) != NULL; q++) {
+            *q = NL;
+          }
         }
-        s++;
-        if (++write_info.bw_len != bufsize) {
+        s = s_end;
+        ptr += n;
+        write_info.bw_len += n;
+        if (write_info.bw_len != bufsize) {
           continue;
         }
         if (buf_write_bytes(&write_info) == FAIL) {
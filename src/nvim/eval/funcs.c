@@ -4037,7 +4037,7 @@ static void find_some_match(typval_T *const argvars, typval_T *const rettv,
     }
   }
 
-  regmatch.regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING);
+  regmatch.regprog = vim_regcomp_cached(pat, RE_MAGIC + RE_STRING);
   if (regmatch.regprog != NULL) {
     regmatch.rm_ic = p_ic;
 
@@ -4132,7 +4132,7 @@ static void find_some_match(typval_T *const argvars, typval_T *const rettv,
         break;
       }
     }
-    vim_regfree(regmatch.regprog);
+    vim_regfree_cached(regmatch.regprog, pat);
   }
 
 theend:
@@ -6935,7 +6935,7 @@ static void f_split(typval_T *argvars, typval_T *rettv, EvalFuncData fptr)
   }
 
   regmatch_T regmatch = {
-    .regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING),
+    .regprog = vim_regcomp_cached(pat, RE_MAGIC + RE_STRING),
     .startp = { NULL },
     .endp = { NULL },
     .rm_ic = false,
@@ -6973,7 +6973,7 @@ static void f_split(typval_T *argvars, typval_T *rettv, EvalFuncData fptr)
       str = regmatch.endp[0];
     }
 
-    vim_regfree(regmatch.regprog);
+    vim_regfree_cached(regmatch.regprog, pat);
   }
 
 theend:
@@ -45,11 +45,14 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "nvim/event/defs.h"
 #include "nvim/event/multiqueue.h"
 #include "nvim/lib/queue_defs.h"
+#include "nvim/macros_defs.h"
 #include "nvim/memory.h"
+#include "nvim/os/time.h"
 
 typedef struct multiqueue_item MultiQueueItem;
 struct multiqueue_item {
@@ -58,6 +61,7 @@ struct multiqueue_item {
     struct {
       Event event;
       MultiQueueItem *parent_item;
+      uint64_t time;  // os_hrtime() when the event was put
     } item;
   } data;
   bool link;  // true: current item is just a link to a node in a child queue
@@ -70,6 +74,9 @@ struct multiqueue {
   PutCallback on_put;  // Called on the parent (if any) when an item is enqueued in a child.
   void *data;
   size_t size;
+  size_t depth;  // number of nodes, including link nodes
+  size_t max_depth;
+  uint64_t max_wait;  // longest time an event waited before it was removed
 };
 
 typedef struct {
@@ -102,6 +109,9 @@ static MultiQueue *_multiqueue_new(MultiQueue *parent, PutCallback on_put, void
   MultiQueue *rv = xmalloc(sizeof(MultiQueue));
   QUEUE_INIT(&rv->headtail);
   rv->size = 0;
+  rv->depth = 0;
+  rv->max_depth = 0;
+  rv->max_wait = 0;
   rv->parent = parent;
   rv->on_put = on_put;
   rv->data = data;
@@ -117,6 +127,7 @@ void multiqueue_free(MultiQueue *self)
     if (self->parent) {
       QUEUE_REMOVE(&item->data.item.parent_item->node);
       xfree(item->data.item.parent_item);
+      self->parent->depth--;
     }
     QUEUE_REMOVE(q);
     xfree(item);
@@ -188,10 +199,23 @@ size_t multiqueue_size(MultiQueue *self)
   return self->size;
 }
 
+/// Gets the number of events in the queue, and the most there were and the
+/// longest time (nanoseconds) an event waited since the previous call.
+void multiqueue_stats(MultiQueue *self, size_t *depth, size_t *max_depth, uint64_t *max_wait)
+  FUNC_ATTR_NONNULL_ALL
+{
+  *depth = self->depth;
+  *max_depth = self->max_depth;
+  *max_wait = self->max_wait;
+  self->max_depth = self->depth;
+  self->max_wait = 0;
+}
+
 /// Gets an Event from an item.
 ///
 /// @param remove   Remove the node from its queue, and free it.
-static Event multiqueueitem_get_event(MultiQueueItem *item, bool remove)
+/// @param[out] time  When the event was put.
+static Event multiqueueitem_get_event(MultiQueueItem *item, bool remove, uint64_t *time)
 {
   assert(item != NULL);
   Event ev;
@@ -202,10 +226,12 @@ static Event multiqueueitem_get_event(MultiQueueItem *item, bool remove)
     MultiQueueItem *child =
       multiqueue_node_data(QUEUE_HEAD(&linked->headtail));
     ev = child->data.item.event;
+    *time = child->data.item.time;
     // remove the child node
     if (remove) {
       QUEUE_REMOVE(&child->node);
       xfree(child);
+      linked->depth--;
     }
   } else {
     // remove the corresponding link node in the parent queue
@@ -215,6 +241,7 @@ static Event multiqueueitem_get_event(MultiQueueItem *item, bool remove)
       item->data.item.parent_item = NULL;
     }
     ev = item->data.item.event;
+    *time = item->data.item.time;
   }
   return ev;
 }
@@ -226,8 +253,14 @@ static Event multiqueue_remove(MultiQueue *self)
   QUEUE_REMOVE(h);
   MultiQueueItem *item = multiqueue_node_data(h);
   assert(!item->link || !self->parent);  // Only a parent queue has link-nodes
-  Event ev = multiqueueitem_get_event(item, true);
+  if (!item->link && item->data.item.parent_item) {
+    self->parent->depth--;
+  }
+  uint64_t time;
+  Event ev = multiqueueitem_get_event(item, true, &time);
   self->size--;
+  self->depth--;
+  self->max_wait = MAX(self->max_wait, os_hrtime() - time);
   xfree(item);
   return ev;
 }
@@ -238,6 +271,7 @@ static void multiqueue_push(MultiQueue *self, Event event)
   item->link = false;
   item->data.item.event = event;
   item->data.item.parent_item = NULL;
+  item->data.item.time = os_hrtime();
   QUEUE_INSERT_TAIL(&self->headtail, &item->node);
   if (self->parent) {
     // push link node to the parent queue
@@ -246,8 +280,12 @@ static void multiqueue_push(MultiQueue *self, Event event)
     item->data.item.parent_item->data.queue = self;
     QUEUE_INSERT_TAIL(&self->parent->headtail,
                       &item->data.item.parent_item->node);
+    self->parent->depth++;
+    self->parent->max_depth = MAX(self->parent->max_depth, self->parent->depth);
   }
   self->size++;
+  self->depth++;
+  self->max_depth = MAX(self->max_depth, self->depth);
 }
 
 static MultiQueueItem *multiqueue_node_data(QUEUE *q)
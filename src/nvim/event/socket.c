@@ -23,6 +23,12 @@
 
 #include "event/socket.c.generated.h"
 
+/// Minimum size of the kernel send and receive buffers of local socket
+/// connections. The default is only 8 KiB on some systems (macOS), then a
+/// full screen redraw or a large buffer transfer needs many round trips
+/// through the kernel.
+#define LOCAL_SOCKET_BUFFER_SIZE (256 * 1024)
+
 /// Checks if an address string looks like a TCP endpoint, and returns the end of the host part.
 ///
 /// @param address Address string
@@ -247,10 +253,29 @@ int socket_watcher_accept(SocketWatcher *watcher, RStream *stream)
     return result;
   }
 
+  if (client->type == UV_NAMED_PIPE) {
+    local_socket_grow_buffers((uv_handle_t *)client);
+  }
   stream_init(NULL, &stream->s, -1, client);
   return 0;
 }
 
+/// Grows the kernel buffers of a local socket to LOCAL_SOCKET_BUFFER_SIZE.
+/// Errors are ignored, e.g. Windows named pipes have no such buffers.
+static void local_socket_grow_buffers(uv_handle_t *handle)
+{
+  int size = 0;
+  if (uv_send_buffer_size(handle, &size) == 0 && size < LOCAL_SOCKET_BUFFER_SIZE) {
+    size = LOCAL_SOCKET_BUFFER_SIZE;
+    uv_send_buffer_size(handle, &size);
+  }
+  size = 0;
+  if (uv_recv_buffer_size(handle, &size) == 0 && size < LOCAL_SOCKET_BUFFER_SIZE) {
+    size = LOCAL_SOCKET_BUFFER_SIZE;
+    uv_recv_buffer_size(handle, &size);
+  }
+}
+
 void socket_watcher_close(SocketWatcher *watcher, socket_close_cb cb)
   FUNC_ATTR_NONNULL_ARG(1)
 {
@@ -342,6 +367,9 @@ tcp_retry:
   status = 1;
   LOOP_PROCESS_EVENTS_UNTIL(&main_loop, NULL, timeout, status != 1);
   if (status == 0) {
+    if (!is_tcp) {
+      local_socket_grow_buffers((uv_handle_t *)uv_stream);
+    }
     success = true;
   } else {
     stream_may_close(&stream->s);
@@ -3745,6 +3745,23 @@ static int do_sub(exarg_T *eap, proftime_T tm, const int cmdpreview_ns,
 
   int timed_out = false;
 
+  // Track per-line data for each match.
+  // Will be sent as a batch to `extmark_splice` after the substitution is done.
+  typedef struct {
+    int start_col;         // Position in new text where replacement goes
+    lpos_T start;          // Match start position in original text
+    lpos_T end;            // Match end position in original text
+    int matchcols;         // Columns deleted from original text
+    bcount_t matchbytes;   // Bytes deleted from original text
+    int subcols;           // Columns in replacement text
+    bcount_t subbytes;     // Bytes in replacement text
+    linenr_T lnum_before;  // Line number before this substitution
+    linenr_T lnum_after;   // Line number after this substitution
+  } LineData;
+
+  // Allocated once and reused for every line, emptied after each line.
+  kvec_t(LineData) line_matches = KV_INITIAL_VALUE;
+
   for (linenr_T lnum = eap->line1;
        lnum <= line2 && !got_quit && !timed_out && !aborting()
        && (cmdpreview_ns <= 0 || preview_lines.lines_needed <= (linenr_T)p_cwh
@@ -3769,22 +3786,6 @@ static int do_sub(exarg_T *eap, proftime_T tm, const int cmdpreview_ns,
       // Track where substitutions started (set once per line).
       linenr_T lnum_start = 0;
 
-      // Track per-line data for each match.
-      // Will be sent as a batch to `extmark_splice` after the substitution is done.
-      typedef struct {
-        int start_col;         // Position in new text where replacement goes
-        lpos_T start;          // Match start position in original text
-        lpos_T end;            // Match end position in original text
-        int matchcols;         // Columns deleted from original text
-        bcount_t matchbytes;   // Bytes deleted from original text
-        int subcols;           // Columns in replacement text
-        bcount_t subbytes;     // Bytes in replacement text
-        linenr_T lnum_before;  // Line number before this substitution
-        linenr_T lnum_after;   // Line number after this substitution
-      } LineData;
-
-      kvec_t(LineData) line_matches = KV_INITIAL_VALUE;
-
       // The new text is build up step by step, to avoid too much
       // copying.  There are these pieces:
       // sub_firstline  The old text, unmodified.
@@ -4195,7 +4196,7 @@ static int do_sub(exarg_T *eap, proftime_T tm, const int cmdpreview_ns,
           lpos_T start = regmatch.startpos[0];
           lpos_T end = regmatch.endpos[0];
           for (i = 0; i < nmatch - 1; i++) {
-            replaced_bytes += (bcount_t)strlen(ml_get((linenr_T)(lnum_start + i))) + 1;
+            replaced_bytes += (bcount_t)ml_get_len((linenr_T)(lnum_start + i)) + 1;
           }
           replaced_bytes += end.col - start.col;
 
@@ -4317,7 +4318,7 @@ skip:
             if (u_savesub(lnum) != OK) {
               break;
             }
-            ml_replace(lnum, new_start.data, true);
+            ml_replace_len(lnum, new_start.data, new_start.size, true);
 
             // Call extmark_splice for each match on this line.
             for (size_t match_idx = 0; match_idx < kv_size(line_matches); match_idx++) {
@@ -4428,7 +4429,7 @@ skip:
       }
       xfree(new_start.data);            // for when substitute was cancelled
       API_CLEAR_STRING(sub_firstline);  // free the copy of the original line
-      kv_destroy(line_matches);         // clean up match data
+      kv_size(line_matches) = 0;        // drop match data of a cancelled line
     }
 
     line_breakcheck();
@@ -4437,6 +4438,7 @@ skip:
       got_quit = true;
     }
   }
+  kv_destroy(line_matches);
 
   curbuf->deleted_bytes2 = 0;
 
@@ -107,6 +107,9 @@ static const char *e_auchangedbuf = N_("E812: Autocommands changed buffer or buf
 // non-ASCII bytes (high bit set) in multiple bytes at once.
 #define NONASCII_MASK (((uint64_t)(-1) / 0xFF) * 0x80)
 
+// Files of at least this size are read in the largest chunks right away.
+#define BIG_FILE_SIZE 0x1000000
+
 /// Shows a message about file `name`, e.g. `"foo.txt" [New]`.
 ///
 /// @param s Info appended to the filename, e.g. "[New]".
@@ -681,6 +684,18 @@ int readfile(char *fname, char *sfname, linenr_T from, linenr_T lines_to_skip,
   // Autocommands may add lines to the file, need to check if it is empty
   wasempty = (curbuf->b_ml.ml_flags & ML_EMPTY);
 
+  // Minimal size of the chunks read from the file.  A big regular file is
+  // read in the largest chunks right away, which saves many small reads and
+  // reallocations, and the kernel is told to read ahead aggressively.
+  ptrdiff_t read_chunk = 0x10000;
+  if (!read_stdin && !read_buffer && !read_fifo && S_ISREG(perm)) {
+    FileInfo fd_info;
+    if (os_fileinfo_fd(fd, &fd_info) && os_fileinfo_size(&fd_info) >= BIG_FILE_SIZE) {
+      read_chunk = 0x100000;
+      os_fadvise_sequential(fd);
+    }
+  }
+
   if (!recoverymode && !filtering && !(flags & READ_DUMMY) && !silent) {
     if (!read_stdin && !read_buffer) {
       filemess(curbuf, sfname, "", NULL);
@@ -910,10 +925,11 @@ retry:
     // up to max_unsigned characters (and other things).
     {
       if (!skip_read) {
-        // Use buffer >= 64K.  Add linerest to double the size if the
-        // line gets very long, to avoid a lot of copying. But don't
-        // read more than 1 Mbyte at a time, so we can be interrupted.
-        size = MIN(0x10000 + linerest, 0x100000);
+        // Use buffer >= 64K (1 Mbyte for a big file).  Add linerest to
+        // double the size if the line gets very long, to avoid a lot of
+        // copying. But don't read more than 1 Mbyte at a time, so we can be
+        // interrupted.
+        size = MIN(read_chunk + linerest, 0x100000);
       }
 
       // Protect against the argument of lalloc() going negative.
@@ -1560,31 +1576,26 @@ rewind_retry:
       // Use memchr() for SIMD-optimized newline scanning instead
       // of scanning each byte individually.
       char *end = ptr + size;
+      // The next NUL byte is looked up once per chunk instead of once per
+      // line, NULs are rare in text files.
+      char *next_nul = memchr(ptr, NUL, (size_t)(end - ptr));
 
       while (ptr < end) {
         char *nl = memchr(ptr, NL, (size_t)(end - ptr));
-        char *nul_scan;
+
+        // Replace NUL bytes with NL before the newline (or in the
+        // remaining data if there are no more newlines in the buffer).
+        while (next_nul != NULL && (nl == NULL || next_nul < nl)) {
+          *next_nul = NL;
+          next_nul = memchr(next_nul + 1, NUL, (size_t)(end - next_nul - 1));
+        }
 
         if (nl == NULL) {
           // No more newlines in buffer.
-          // Replace any NUL bytes with NL in remaining data.
-          while ((nul_scan = memchr(ptr, NUL, (size_t)(end - ptr))) != NULL) {
-            *nul_scan = NL;
-            ptr = nul_scan + 1;
-          }
           ptr = end;
           break;
         }
 
-        // Replace NUL bytes with NL before the newline.
-        {
-          char *scan = ptr;
-          while ((nul_scan = memchr(scan, NUL, (size_t)(nl - scan))) != NULL) {
-            *nul_scan = NL;
-            scan = nul_scan + 1;
-          }
-        }
-
         // Process the newline.
         ptr = nl;
         if (skip_count == 0) {
@@ -45,7 +45,7 @@ enum {
   CONV_RESTLEN = 30,
 };
 
-enum { WRITEBUFSIZE = 8192, };  ///< size of normal write buffer
+enum { WRITEBUFSIZE = 65536, };  ///< size of normal write buffer
 
 enum {
   /// We have to guess how much a sequence of bytes may expand when converting
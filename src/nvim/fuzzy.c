@@ -70,11 +70,15 @@ typedef struct match_struct match_struct;
 
 /// fuzzy_match()
 ///
+/// "block" is a growarray of score_t that can be passed when matching many
+/// strings, to reuse the memory of the score matrices.  Can be NULL.
+///
 /// @return true if "pat_arg" matches "str". Also returns the match score in
 /// "outScore" and the matching character positions in "matches".
 bool fuzzy_match(char *const str, const char *const pat_arg, const bool matchseq,
-                 int *const outScore, uint32_t *const matches, const int maxMatches)
-  FUNC_ATTR_NONNULL_ALL
+                 int *const outScore, uint32_t *const matches, const int maxMatches,
+                 garray_T *const block)
+  FUNC_ATTR_NONNULL_ARG(1, 2, 4, 5)
 {
   bool complete = false;
   int numMatches = 0;
@@ -119,7 +123,7 @@ bool fuzzy_match(char *const str, const char *const pat_arg, const bool matchseq
 
     int score = FUZZY_SCORE_NONE;
     if (has_match(pat, str)) {
-      score_t fzy_score = match_positions(pat, str, matches + numMatches);
+      score_t fzy_score = match_positions(pat, str, matches + numMatches, block);
       if (fzy_score != (score_t)SCORE_MIN) {
         score = (fzy_score == (score_t)SCORE_MAX)
                 ? INT_MAX
@@ -214,6 +218,8 @@ static void fuzzy_match_in_list(list_T *const l, char *const str, const bool mat
   fuzzyItem_T *const items = xcalloc((size_t)len, sizeof(fuzzyItem_T));
   int match_count = 0;
   uint32_t matches[FUZZY_MATCH_MAX_LEN];
+  garray_T block;
+  fuzzy_block_init(&block);
 
   // For all the string items in items, get the fuzzy matching score
   TV_LIST_ITER(l, li, {
@@ -255,7 +261,7 @@ static void fuzzy_match_in_list(list_T *const l, char *const str, const bool mat
 
     int score;
     if (itemstr != NULL
-        && fuzzy_match(itemstr, str, matchseq, &score, matches, FUZZY_MATCH_MAX_LEN)) {
+        && fuzzy_match(itemstr, str, matchseq, &score, matches, FUZZY_MATCH_MAX_LEN, &block)) {
       char *itemstr_copy = itemstr_allocate ? xstrdup(itemstr) : itemstr;
       list_T *match_positions = NULL;
 
@@ -287,6 +293,7 @@ static void fuzzy_match_in_list(list_T *const l, char *const str, const bool mat
     }
     tv_clear(&rettv);
   });
+  ga_clear(&block);
 
   if (match_count > 0) {
     // Sort the list by the descending order of the match score
@@ -485,10 +492,26 @@ static void fuzzy_match_func_sort(fuzmatch_str_T *const fm, const int sz)
   qsort(fm, (size_t)sz, sizeof(fuzmatch_str_T), fuzzy_match_func_compare);
 }
 
+/// Initialize "block" for passing to fuzzy_match() or fuzzy_match_str_block().
+/// Free it with ga_clear() when done.
+void fuzzy_block_init(garray_T *const block)
+  FUNC_ATTR_NONNULL_ALL
+{
+  ga_init(block, (int)sizeof(score_t), 256);
+}
+
 /// Fuzzy match "pat" in "str".
 /// @returns 0 if there is no match. Otherwise, returns the match score.
 int fuzzy_match_str(char *const str, const char *const pat)
   FUNC_ATTR_WARN_UNUSED_RESULT
+{
+  return fuzzy_match_str_block(str, pat, NULL);
+}
+
+/// Like fuzzy_match_str(), reusing "block" from fuzzy_block_init() for the
+/// score matrices when matching many strings.
+int fuzzy_match_str_block(char *const str, const char *const pat, garray_T *const block)
+  FUNC_ATTR_WARN_UNUSED_RESULT
 {
   if (str == NULL || pat == NULL) {
     return 0;
@@ -496,7 +519,7 @@ int fuzzy_match_str(char *const str, const char *const pat)
 
   int score = FUZZY_SCORE_NONE;
   uint32_t matchpos[FUZZY_MATCH_MAX_LEN];
-  fuzzy_match(str, pat, true, &score, matchpos, ARRAY_SIZE(matchpos));
+  fuzzy_match(str, pat, true, &score, matchpos, ARRAY_SIZE(matchpos), block);
 
   return score;
 }
@@ -514,7 +537,7 @@ garray_T *fuzzy_match_str_with_pos(char *const str, const char *const pat)
 
   int score = FUZZY_SCORE_NONE;
   uint32_t matches[FUZZY_MATCH_MAX_LEN];
-  if (!fuzzy_match(str, pat, false, &score, matches, FUZZY_MATCH_MAX_LEN)
+  if (!fuzzy_match(str, pat, false, &score, matches, FUZZY_MATCH_MAX_LEN, NULL)
       || score == FUZZY_SCORE_NONE) {
     ga_clear(match_positions);
     xfree(match_positions);
@@ -755,6 +778,24 @@ static int has_match(const char *const needle, const char *const haystack)
   const char *n_ptr = needle;
   const char *h_ptr = haystack;
 
+  // ASCII characters of "needle" are found by comparing bytes, the bytes of a
+  // multibyte character in "haystack" can't be equal to them.
+  while ((uint8_t)(*n_ptr) < 0x80 && *n_ptr != NUL) {
+    const int n_char = (uint8_t)(*n_ptr);
+    const int n_upper = mb_toupper(n_char);
+    if (n_upper >= 0x80) {
+      break;
+    }
+    while (*h_ptr != NUL && (uint8_t)(*h_ptr) != n_char && (uint8_t)(*h_ptr) != n_upper) {
+      h_ptr++;
+    }
+    if (*h_ptr == NUL) {
+      return FAIL;
+    }
+    h_ptr += utfc_ptr2len(h_ptr);
+    n_ptr += utfc_ptr2len(n_ptr);
+  }
+
   while (*n_ptr) {
     const int n_char = utf_ptr2char(n_ptr);
     bool found = false;
@@ -876,8 +917,9 @@ static inline void match_row(const match_struct *match, int row, score_t *curr_D
   }
 }
 
+/// @param block  growarray for the score matrices, can be NULL
 static score_t match_positions(const char *const needle, const char *const haystack,
-                               uint32_t *const positions)
+                               uint32_t *const positions, garray_T *block)
 {
   if (!needle || !haystack || !*needle) {
     return (score_t)SCORE_MIN;
@@ -915,23 +957,30 @@ static score_t match_positions(const char *const needle, const char *const hayst
     }
   }
 
-  // ensure n * MATCH_MAX_LEN * 2 won't overflow
-  if ((size_t)n > (SIZE_MAX / sizeof(score_t)) / MATCH_MAX_LEN / 2) {
+  // ensure n * m * 2 won't overflow
+  if ((size_t)n > (SIZE_MAX / sizeof(score_t)) / (size_t)m / 2) {
     return (score_t)SCORE_MIN;
   }
 
-  // Allocate for both D and M matrices in one contiguous block
-  score_t *block = (score_t *)xmalloc(sizeof(score_t) * MATCH_MAX_LEN * (size_t)n * 2);
+  // Both D and M matrices are in one contiguous block, with rows of "m"
+  // scores.  A block passed by the caller is reused for the next candidate.
+  garray_T local_block;
+  if (block == NULL) {
+    fuzzy_block_init(&local_block);
+    block = &local_block;
+  }
+  block->ga_len = 0;
+  ga_grow(block, n * m * 2);
+  score_t *const match_block = (score_t *)block->ga_data;
 
   // D[][] Stores the best score for this position ending with a match.
   // M[][] Stores the best possible score at this position.
-  score_t(*D)[MATCH_MAX_LEN] = (score_t(*)[MATCH_MAX_LEN])(block);
-  score_t(*M)[MATCH_MAX_LEN] = (score_t(*)[MATCH_MAX_LEN])(block
-                                                           + MATCH_MAX_LEN * (size_t)n);
+#define D(i, j) match_block[(size_t)(i) * (size_t)m + (size_t)(j)]
+#define M(i, j) match_block[((size_t)n + (size_t)(i)) * (size_t)m + (size_t)(j)]
 
-  match_row(&match, 0, D[0], M[0], D[0], M[0]);
+  match_row(&match, 0, &D(0, 0), &M(0, 0), &D(0, 0), &M(0, 0));
   for (int i = 1; i < n; i++) {
-    match_row(&match, i, D[i], M[i], D[i - 1], M[i - 1]);
+    match_row(&match, i, &D(i, 0), &M(i, 0), &D(i - 1, 0), &M(i - 1, 0));
   }
 
   // backtrace to find the positions of optimal matching
@@ -945,13 +994,13 @@ static score_t match_positions(const char *const needle, const char *const hayst
         // For simplicity, we will pick the first one
         // we encounter, the latest in the candidate
         // string.
-        if (D[i][j] != (score_t)SCORE_MIN
-            && (match_required || D[i][j] == M[i][j])) {
+        if (D(i, j) != (score_t)SCORE_MIN
+            && (match_required || D(i, j) == M(i, j))) {
           // If this score was determined using
           // SCORE_MATCH_CONSECUTIVE, the
           // previous character MUST be a match
           match_required = i && j
-                           && M[i][j] == D[i - 1][j - 1] + SCORE_MATCH_CONSECUTIVE;
+                           && M(i, j) == D(i - 1, j - 1) + SCORE_MATCH_CONSECUTIVE;
           positions[i] = (uint32_t)(j--);
           break;
         }
@@ -959,8 +1008,13 @@ static score_t match_positions(const char *const needle, const char *const hayst
     }
   }
 
-  score_t result = M[n - 1][m - 1];
+  score_t result = M(n - 1, m - 1);
 
-  xfree(block);
+#undef D
+#undef M
+
+  if (block == &local_block) {
+    ga_clear(&local_block);
+  }
   return result;
 }
@@ -88,7 +88,10 @@ EXTERN struct nvim_stats_s {
   int64_t fsync;
   int64_t redraw;
   int16_t log_skip;  // How many logs were tried and skipped before log_init.
-} g_stats INIT( = { 0, 0, 0 });
+  int64_t mf_released;  // Bytes of buffer text released to the swapfile.
+  int64_t regexp_cache_hit;   // vim_regcomp_cached() reused a program.
+  int64_t regexp_cache_miss;  // vim_regcomp_cached() had to compile.
+} g_stats INIT( = { 0, 0, 0, 0, 0, 0 });
 
 // Values for "starting".
 #define NO_SCREEN       2       // no screen updating yet
@@ -1606,15 +1606,18 @@ static void set_fuzzy_score(void)
   }
 
   // Score all completion matches
+  garray_T block;
+  fuzzy_block_init(&block);
   compl_T *comp = compl_first_match;
   do {
     if (use_leader) {
       pattern = get_leader_for_startcol(comp, true)->data;
     }
 
-    comp->cp_score = fuzzy_match_str(comp->cp_str.data, pattern);
+    comp->cp_score = fuzzy_match_str_block(comp->cp_str.data, pattern, &block);
     comp = comp->cp_next;
   } while (comp != NULL && !is_first_match(comp));
+  ga_clear(&block);
 }
 
 /// Sort completion matches, excluding the node that contains the leader.
@@ -4153,14 +4156,17 @@ static void get_next_filename_completion(void)
     ga_init(&fuzzy_indices, sizeof(int), 10);
     compl_fuzzy_scores = (int *)xmalloc(sizeof(int) * (size_t)num_matches);
 
+    garray_T block;
+    fuzzy_block_init(&block);
     for (int i = 0; i < num_matches; i++) {
       char *ptr = matches[i];
-      int score = fuzzy_match_str(ptr, leader);
+      int score = fuzzy_match_str_block(ptr, leader, &block);
       if (score != FUZZY_SCORE_NONE) {
         GA_APPEND(int, &fuzzy_indices, i);
         compl_fuzzy_scores[i] = score;
       }
     }
+    ga_clear(&block);
 
     // prevent qsort from deref NULL pointer
     if (fuzzy_indices.ga_len > 0) {
@@ -32,6 +32,7 @@
 /// mf_free()         remove a block
 /// mf_sync()         sync changed parts of memfile to disk
 /// mf_release_all()  release as much memory as possible
+/// mf_release_clean() release blocks that are unchanged in the file
 /// mf_trans_del()    may translate negative to positive block number
 /// mf_fullname()     make file name full path (use before first :cd)
 
@@ -41,9 +42,12 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 
+#include "auto/config.h"
+#include "klib/kvec.h"
 #include "nvim/assert_defs.h"
 #include "nvim/buffer_defs.h"
 #include "nvim/errors.h"
@@ -66,7 +70,12 @@
 #include "nvim/types_defs.h"
 #include "nvim/vim_defs.h"
 
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>
+#endif
+
 #define MEMFILE_PAGE_SIZE 4096       /// default page size
+#define MF_MAX_RUN 64                /// max nr of blocks written at once by mf_sync()
 
 #include "memfile.c.generated.h"
 
@@ -387,43 +396,73 @@ int mf_sync(memfile_T *mfp, int flags)
   // Only a CTRL-C while writing will break us here, not one typed previously.
   got_int = false;
 
-  // Sync from last to first (may reduce the probability of an inconsistent
-  // file). If a write fails, it is very likely caused by a full filesystem.
-  // Then we only try to write blocks within the existing file. If that also
-  // fails then we give up.
-  int status = OK;
-  bhdr_T *hp = NULL;
-  // note, "last" block is typically earlier in the hash list
+  // Collect the blocks to write and write them in the order of their place in
+  // the file, so that blocks which follow each other are written with one
+  // system call.  If a write fails, it is very likely caused by a full
+  // filesystem.  Then we only try to write blocks within the existing file.
+  // If that also fails then we give up.
+  kvec_t(bhdr_T *) blocks = KV_INITIAL_VALUE;
+  bhdr_T *hp;
   map_foreach_value(&mfp->mf_hash, hp, {
     if (((flags & MFS_ALL) || hp->bh_bnum >= 0)
         && (hp->bh_flags & BH_DIRTY)
-        && (status == OK || (hp->bh_bnum >= 0
-                             && hp->bh_bnum < mfp->mf_infile_count))) {
-      if ((flags & MFS_ZERO) && hp->bh_bnum != 0) {
-        continue;
-      }
-      if (mf_write(mfp, hp) == FAIL) {
-        if (status == FAIL) {   // double error: quit syncing
-          break;
-        }
-        status = FAIL;
+        && (!(flags & MFS_ZERO) || hp->bh_bnum == 0)) {
+      kv_push(blocks, hp);
+    }
+  })
+  // Blocks with a negative number get their place in the file now.
+  for (size_t i = 0; i < kv_size(blocks); i++) {
+    mf_trans_add(mfp, kv_A(blocks, i));
+  }
+  if (kv_size(blocks) > 1) {
+    qsort(blocks.items, kv_size(blocks), sizeof(bhdr_T *), mf_bnum_cmp);
+  }
+
+  int status = OK;
+  size_t i = 0;
+  while (i < kv_size(blocks)) {
+    bhdr_T *first = kv_A(blocks, i);
+    if (status == FAIL && first->bh_bnum >= mfp->mf_infile_count) {
+      i++;
+      continue;
+    }
+    // A block beyond the end of the file is written by itself, mf_write()
+    // fills the gap in front of it.
+    size_t count = 1;
+    if (first->bh_bnum <= mfp->mf_infile_count) {
+      blocknr_T next = first->bh_bnum + (blocknr_T)first->bh_page_count;
+      while (i + count < kv_size(blocks) && count < MF_MAX_RUN
+             && kv_A(blocks, i + count)->bh_bnum == next
+             && (status == OK || next < mfp->mf_infile_count)) {
+        next += (blocknr_T)kv_A(blocks, i + count)->bh_page_count;
+        count++;
       }
-      if (flags & MFS_STOP) {   // Stop when char available now.
-        if (os_char_avail()) {
-          break;
-        }
-      } else if (!main_loop.recursive) {  // May reach here on OOM in libuv callback
-        os_breakcheck();
+    }
+    int run_status = count > 1 ? mf_write_run(mfp, blocks.items + i, count) : mf_write(mfp, first);
+    i += count;
+    if (run_status == FAIL) {
+      if (status == FAIL) {   // double error: quit syncing
+        break;
       }
-      if (got_int) {
+      status = FAIL;
+    }
+    if (flags & MFS_STOP) {   // Stop when char available now.
+      if (os_char_avail()) {
         break;
       }
+    } else if (!main_loop.recursive) {  // May reach here on OOM in libuv callback
+      os_breakcheck();
     }
-  })
+    if (got_int) {
+      break;
+    }
+  }
+  bool all_written = i >= kv_size(blocks);
+  kv_destroy(blocks);
 
   // If the whole list is flushed, the memfile is not dirty anymore.
   // In case of an error, dirty flag is also set, to avoid trying all the time.
-  if (hp == NULL || status == FAIL) {
+  if (all_written || status == FAIL) {
     mfp->mf_dirty = MF_DIRTY_NO;
   }
 
@@ -489,6 +528,53 @@ bool mf_release_all(void)
   return retval;
 }
 
+/// Release the memory of blocks that are in the swapfile and were not changed
+/// since they were written.  mf_get() reads them back when they are needed.
+///
+/// Block zero is kept, ml_upd_block0() expects it to be in memory.
+///
+/// @return  Number of bytes released.
+size_t mf_release_clean(memfile_T *mfp)
+{
+  size_t released = 0;
+
+  if (mfp->mf_fd < 0) {
+    return 0;
+  }
+  for (int i = 0; i < (int)map_size(&mfp->mf_hash);) {
+    bhdr_T *hp = mfp->mf_hash.values[i];
+    if (!(hp->bh_flags & (BH_LOCKED | BH_DIRTY))
+        && hp->bh_bnum > 0 && hp->bh_bnum < mfp->mf_infile_count) {
+      released += (size_t)mfp->mf_page_size * hp->bh_page_count;
+      pmap_del(int64_t)(&mfp->mf_hash, hp->bh_bnum, NULL);
+      mf_free_bhdr(hp);
+      // Rerun with the same value of i. another item will have taken
+      // its place (or it was the last)
+    } else {
+      i++;
+    }
+  }
+  return released;
+}
+
+/// Get the memory used by the blocks of all memfiles.
+///
+/// @return  Number of bytes.
+size_t mf_mem_used(void)
+{
+  size_t used = 0;
+  FOR_ALL_BUFFERS(buf) {
+    memfile_T *mfp = buf->b_ml.ml_mfp;
+    if (mfp != NULL) {
+      bhdr_T *hp;
+      map_foreach_value(&mfp->mf_hash, hp, {
+        used += (size_t)mfp->mf_page_size * hp->bh_page_count;
+      })
+    }
+  }
+  return used;
+}
+
 /// Allocate a block header and a block of memory for it.
 static bhdr_T *mf_alloc_bhdr(memfile_T *mfp, unsigned page_count)
 {
@@ -552,6 +638,60 @@ static int mf_read(memfile_T *mfp, bhdr_T *hp)
   return OK;
 }
 
+/// Compare the numbers of two blocks, for qsort().
+static int mf_bnum_cmp(const void *a, const void *b)
+{
+  blocknr_T nr_a = (*(const bhdr_T *const *)a)->bh_bnum;
+  blocknr_T nr_b = (*(const bhdr_T *const *)b)->bh_bnum;
+  return nr_a < nr_b ? -1 : nr_a > nr_b;
+}
+
+/// Write blocks that follow each other in the file with one system call.
+/// When that fails the blocks are written one by one with mf_write(), which
+/// also handles re-opening the file and the error message.
+///
+/// @param blocks  "count" blocks, the first one is not beyond the end of the
+///                file and each next one starts where the previous one ends.
+///
+/// @return  OK    On success.
+///          FAIL  On failure.
+static int mf_write_run(memfile_T *mfp, bhdr_T **blocks, size_t count)
+{
+#ifdef HAVE_READV
+  if (mfp->mf_fd >= 0) {
+    struct iovec iov[MF_MAX_RUN];
+    size_t size = 0;
+    assert(count <= MF_MAX_RUN);
+    for (size_t i = 0; i < count; i++) {
+      iov[i].iov_base = blocks[i]->bh_data;
+      iov[i].iov_len = (size_t)mfp->mf_page_size * blocks[i]->bh_page_count;
+      size += iov[i].iov_len;
+    }
+    off_T offset = (off_T)mfp->mf_page_size * blocks[0]->bh_bnum;
+    if (vim_lseek(mfp->mf_fd, offset, SEEK_SET) == offset
+        && os_writev(mfp->mf_fd, iov, count) == (ptrdiff_t)size) {
+      did_swapwrite_msg = false;
+      for (size_t i = 0; i < count; i++) {
+        blocks[i]->bh_flags &= ~BH_DIRTY;
+      }
+      bhdr_T *last = blocks[count - 1];
+      if (last->bh_bnum + (blocknr_T)last->bh_page_count > mfp->mf_infile_count) {
+        mfp->mf_infile_count = last->bh_bnum + (blocknr_T)last->bh_page_count;
+      }
+      return OK;
+    }
+  }
+#endif
+
+  int status = OK;
+  for (size_t i = 0; i < count; i++) {
+    if (mf_write(mfp, blocks[i]) == FAIL) {
+      status = FAIL;
+    }
+  }
+  return status;
+}
+
 /// Write a block to disk.
 ///
 /// @return  OK    On success.
@@ -225,6 +225,9 @@ typedef struct {
 
 #define STACK_INCR      5       // nr of entries added to ml_stack at a time
 
+// Hidden buffers with fewer blocks in memory are not moved to the swapfile.
+#define ML_HIDDEN_MIN_BLOCKS 16
+
 // The line number where the first mark may be is remembered.
 // If it is 0 there are no marks at all.
 // (always used for the current buffer only, no buffer change possible while
@@ -295,6 +298,7 @@ int ml_open(buf_T *buf)
   buf->b_ml.ml_line_offset = 0;
   buf->b_ml.ml_chunksize = NULL;
   buf->b_ml.ml_usedchunks = 0;
+  ml_chunk_cache_reset(buf);
 
   if (cmdmod.cmod_flags & CMOD_NOSWAPFILE) {
     buf->b_p_swf = false;
@@ -1703,6 +1707,7 @@ static int recov_file_names(char **names, char *path, bool prepend_dot)
 /// always sync at least one block.
 void ml_sync_all(int check_file, int check_char, bool do_fsync)
 {
+  bool did_write_hidden = false;
   FOR_ALL_BUFFERS(buf) {
     if (buf->b_ml.ml_mfp == NULL || buf->b_ml.ml_mfp->mf_fname == NULL) {
       continue;                             // no file
@@ -1731,9 +1736,50 @@ void ml_sync_all(int check_file, int check_char, bool do_fsync)
         break;
       }
     }
+    // When idle, move the text of hidden buffers out of memory.  Write the
+    // text of at most one buffer each time, the others follow later.
+    if (check_file && buf->b_nwindows == 0 && buf != curbuf && !did_write_hidden) {
+      did_write_hidden = ml_release_hidden(buf, check_char);
+      if (check_char && os_char_avail()) {      // character available now
+        break;
+      }
+    }
   }
 }
 
+/// Release the memory used for the text of a buffer that is not displayed in
+/// any window, after writing all of it to the swapfile.  The blocks are read
+/// back from the swapfile when the text is needed again.
+///
+/// @param check_char  if true, stop writing when a character becomes available,
+///                    the memory is then released in a later call.
+///
+/// @return  true if blocks had to be written.
+static bool ml_release_hidden(buf_T *buf, bool check_char)
+{
+  memfile_T *mfp = buf->b_ml.ml_mfp;
+
+  if (mfp->mf_fd < 0 || map_size(&mfp->mf_hash) < ML_HIDDEN_MIN_BLOCKS) {
+    return false;
+  }
+  // Blocks with a negative number only exist in memory, preserve them first.
+  bool did_write = mf_need_trans(mfp) || mfp->mf_dirty != MF_DIRTY_NO;
+  if (did_write) {
+    int status = mf_sync(mfp, MFS_ALL | (check_char ? MFS_STOP : 0));
+    buf->b_ml.ml_stack_top = 0;  // stack is invalid after mf_sync(.., MFS_ALL)
+    if (status == FAIL || mfp->mf_dirty != MF_DIRTY_NO) {
+      return true;  // stopped or failed, keep the text in memory
+    }
+    // Update the pointer blocks for the blocks that got a positive number.
+    ml_preserve(buf, false, false);
+    if (got_int || mf_need_trans(mfp)) {
+      return true;
+    }
+  }
+  g_stats.mf_released += (int64_t)mf_release_clean(mfp);
+  return did_write;
+}
+
 /// sync one buffer, including negative blocks
 ///
 /// after this all the blocks are in the swapfile
@@ -3821,6 +3867,70 @@ enum {
   MLCS_MINL = 400,  // should be half of MLCS_MAXL
 };
 
+/// Forget the chunk found by the last chunk lookup.
+/// Needed when chunks are inserted or removed.
+static void ml_chunk_cache_reset(buf_T *buf)
+{
+  buf->b_ml.ml_chunk_cache_ix = 0;
+  buf->b_ml.ml_chunk_cache_lnum = 1;
+  buf->b_ml.ml_chunk_cache_size = 0;
+}
+
+/// Find the chunk containing line "lnum" (when not zero) or byte "offset".
+/// Starts from the chunk found by the previous lookup and walks backward or
+/// forward from there, so that lookups near the last one (e.g. for a series
+/// of edits) don't walk the chunk list from the start.
+///
+/// @param ffdos  count one extra byte per line for "offset"
+/// @param[out] curlinep  first line in the chunk
+/// @param[out] curixp  index of the chunk
+///
+/// @return  number of bytes before the chunk, including CRs when "offset" is
+///          used with "ffdos"
+static int ml_find_chunk(buf_T *buf, linenr_T lnum, int offset, int ffdos, linenr_T *curlinep,
+                         int *curixp)
+{
+  memline_T *ml = &buf->b_ml;
+  // Extra CR characters are only counted when looking for an offset.
+  int cr = (offset != 0 && ffdos) ? 1 : 0;
+
+  if (ml->ml_chunk_cache_ix >= ml->ml_usedchunks) {
+    ml_chunk_cache_reset(buf);
+  }
+  int curix = ml->ml_chunk_cache_ix;
+  linenr_T curline = ml->ml_chunk_cache_lnum;
+  int size = ml->ml_chunk_cache_size + cr * (curline - 1);
+
+  // Go back while the chunk starts after what we are looking for.
+  while (curix > 0
+         && ((lnum != 0 && lnum < curline) || (offset != 0 && offset <= size))) {
+    curix--;
+    curline -= ml->ml_chunksize[curix].mlcs_numlines;
+    size -= ml->ml_chunksize[curix].mlcs_totalsize + cr * ml->ml_chunksize[curix].mlcs_numlines;
+  }
+
+  // Go forward to the chunk containing our line. Last chunk is special
+  // because it will never qualify.
+  while (curix < ml->ml_usedchunks - 1
+         && ((lnum != 0
+              && lnum >= curline + ml->ml_chunksize[curix].mlcs_numlines)
+             || (offset != 0
+                 && offset > size + ml->ml_chunksize[curix].mlcs_totalsize
+                 + ffdos * ml->ml_chunksize[curix].mlcs_numlines))) {
+    curline += ml->ml_chunksize[curix].mlcs_numlines;
+    size += ml->ml_chunksize[curix].mlcs_totalsize + cr * ml->ml_chunksize[curix].mlcs_numlines;
+    curix++;
+  }
+
+  ml->ml_chunk_cache_ix = curix;
+  ml->ml_chunk_cache_lnum = curline;
+  ml->ml_chunk_cache_size = size - cr * (curline - 1);
+
+  *curlinep = curline;
+  *curixp = curix;
+  return size;
+}
+
 /// Keep information for finding byte offset of a line
 ///
 /// @param updtype  may be one of:
@@ -3848,6 +3958,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
     buf->b_ml.ml_usedchunks = 1;
     buf->b_ml.ml_chunksize[0].mlcs_numlines = 1;
     buf->b_ml.ml_chunksize[0].mlcs_totalsize = 1;
+    ml_chunk_cache_reset(buf);
   }
 
   if (updtype == ML_CHNK_UPDLINE && buf->b_ml.ml_line_count == 1) {
@@ -3855,6 +3966,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
     buf->b_ml.ml_usedchunks = 1;
     buf->b_ml.ml_chunksize[0].mlcs_numlines = 1;
     buf->b_ml.ml_chunksize[0].mlcs_totalsize = buf->b_ml.ml_line_textlen;
+    ml_chunk_cache_reset(buf);
     return;
   }
 
@@ -3862,13 +3974,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
   // chunk.
   if (buf != ml_upd_lastbuf || line != ml_upd_lastline + 1
       || updtype != ML_CHNK_ADDLINE) {
-    for (curline = 1, curix = 0;
-         curix < buf->b_ml.ml_usedchunks - 1
-         && line >= curline +
-         buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-         curix++) {
-      curline += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-    }
+    ml_find_chunk(buf, line, 0, 0, &curline, &curix);
   } else if (curix < buf->b_ml.ml_usedchunks - 1
              && line >= curline + buf->b_ml.ml_chunksize[curix].mlcs_numlines) {
     // Adjust cached curix & curline
@@ -3881,6 +3987,15 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
     len = -len;
   }
   curchnk->mlcs_totalsize += len;
+  // Keep the cached position of a later chunk valid.
+  if (curix < buf->b_ml.ml_chunk_cache_ix) {
+    buf->b_ml.ml_chunk_cache_size += len;
+    if (updtype == ML_CHNK_ADDLINE) {
+      buf->b_ml.ml_chunk_cache_lnum++;
+    } else if (updtype == ML_CHNK_DELLINE) {
+      buf->b_ml.ml_chunk_cache_lnum--;
+    }
+  }
   if (updtype == ML_CHNK_ADDLINE) {
     int rest;
     DataBlock *dp;
@@ -3900,6 +4015,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
       memmove(buf->b_ml.ml_chunksize + curix + 1,
               buf->b_ml.ml_chunksize + curix,
               (size_t)(buf->b_ml.ml_usedchunks - curix) * sizeof(chunksize_T));
+      ml_chunk_cache_reset(buf);
       // Compute length of first half of lines in the split chunk
       int size = 0;
       int linecnt = 0;
@@ -3978,6 +4094,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
       curchnk = buf->b_ml.ml_chunksize + curix;
     } else if (curix == 0 && curchnk->mlcs_numlines <= 0) {
       buf->b_ml.ml_usedchunks--;
+      ml_chunk_cache_reset(buf);
       memmove(buf->b_ml.ml_chunksize, buf->b_ml.ml_chunksize + 1,
               (size_t)buf->b_ml.ml_usedchunks * sizeof(chunksize_T));
       return;
@@ -3992,6 +4109,7 @@ static void ml_updatechunk(buf_T *buf, linenr_T line, int len, int updtype)
     curchnk[-1].mlcs_numlines += curchnk->mlcs_numlines;
     curchnk[-1].mlcs_totalsize += curchnk->mlcs_totalsize;
     buf->b_ml.ml_usedchunks--;
+    ml_chunk_cache_reset(buf);
     if (curix < buf->b_ml.ml_usedchunks) {
       memmove(buf->b_ml.ml_chunksize + curix,
               buf->b_ml.ml_chunksize + curix + 1,
@@ -4059,25 +4177,10 @@ int ml_find_line_or_offset(buf_T *buf, linenr_T lnum, int *offp, bool no_ff)
   if (lnum == 0 && offset <= 0) {
     return 1;       // Not a "find offset" and offset 0 _must_ be in line 1
   }
-  // Find the last chunk before the one containing our line. Last chunk is
-  // special because it will never qualify.
-  linenr_T curline = 1;
-  int curix = 0;
-  int size = 0;
-  while (curix < buf->b_ml.ml_usedchunks - 1
-         && ((lnum != 0
-              && lnum >= curline + buf->b_ml.ml_chunksize[curix].mlcs_numlines)
-             || (offset != 0
-                 && offset > size +
-                 buf->b_ml.ml_chunksize[curix].mlcs_totalsize
-                 + ffdos * buf->b_ml.ml_chunksize[curix].mlcs_numlines))) {
-    curline += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-    size += buf->b_ml.ml_chunksize[curix].mlcs_totalsize;
-    if (offset && ffdos) {
-      size += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-    }
-    curix++;
-  }
+  // Find the chunk containing our line.
+  linenr_T curline;
+  int curix;
+  int size = ml_find_chunk(buf, lnum, offset, ffdos, &curline, &curix);
 
   while ((lnum != 0 && curline < lnum) || (offset != 0 && size < offset)) {
     if (curline > buf->b_ml.ml_line_count
@@ -70,4 +70,7 @@ typedef struct {
   chunksize_T *ml_chunksize;
   int ml_numchunks;
   int ml_usedchunks;
+  int ml_chunk_cache_ix;          // chunk found by the last chunk lookup
+  linenr_T ml_chunk_cache_lnum;   // first line in that chunk
+  int ml_chunk_cache_size;        // number of bytes before that chunk
 } memline_T;
@@ -246,7 +246,27 @@ static ChannelCallFrame *find_call_frame(RpcState *rpc, uint32_t request_id)
   return NULL;
 }
 
+/// Handles all complete messages received on the channel.
+///
+/// Responses to requests handled right away (fast requests) are collected and
+/// written together when all messages have been handled, instead of doing a
+/// write for every response.
 static void parse_msgpack(Channel *channel)
+{
+  bool was_batching = channel->rpc.batching;
+  if (channel->streamtype != kChannelStreamInternal) {
+    channel->rpc.batching = true;
+  }
+
+  parse_msgpack_messages(channel);
+
+  channel->rpc.batching = was_batching;
+  if (!was_batching) {
+    rpc_batch_write(channel);
+  }
+}
+
+static void parse_msgpack_messages(Channel *channel)
 {
   Unpacker *p = channel->rpc.unpacker;
   while (unpacker_advance(p)) {
@@ -399,6 +419,9 @@ static bool channel_write(Channel *channel, WBuffer *buffer)
 {
   int err = 0;
 
+  // Keep messages in order: responses collected so far go first.
+  rpc_batch_write(channel);
+
   if (channel->rpc.closed) {
     wstream_release_wbuffer(buffer);
     return false;
@@ -543,6 +566,9 @@ void rpc_free(Channel *channel)
 
   kv_destroy(channel->rpc.call_stack);
   api_free_dict(channel->rpc.info);
+  if (channel->rpc.batch.startptr != NULL) {
+    free_block(channel->rpc.batch.startptr);
+  }
 }
 
 /// Closes a channel after receiving fatal error, and logs a message.
@@ -603,28 +629,38 @@ void serialize_response(Channel *channel, MsgpackRpcRequestHandler handler, Mess
     return;
   }
 
-  PackerBuffer packer;
-  packer_buffer_init_channels(&channel, 1, &packer);
+  PackerBuffer buf;
+  PackerBuffer *packer = &buf;
+  if (channel->rpc.batching && !channel->rpc.closed) {
+    packer = &channel->rpc.batch;
+    if (packer->startptr == NULL) {
+      rpc_batch_init(channel);
+    }
+  } else {
+    packer_buffer_init_channels(&channel, 1, packer);
+  }
 
-  mpack_array(&packer.ptr, 4);
-  mpack_w(&packer.ptr, 1);
-  mpack_uint(&packer.ptr, response_id);
+  mpack_array(&packer->ptr, 4);
+  mpack_w(&packer->ptr, 1);
+  mpack_uint(&packer->ptr, response_id);
 
   if (ERROR_SET(err)) {
     // error represented by a [type, message] array
-    mpack_array(&packer.ptr, 2);
-    mpack_integer(&packer.ptr, err->type);
-    mpack_str(cstr_as_string(err->msg), &packer);
+    mpack_array(&packer->ptr, 2);
+    mpack_integer(&packer->ptr, err->type);
+    mpack_str(cstr_as_string(err->msg), packer);
     // Nil result
-    mpack_nil(&packer.ptr);
+    mpack_nil(&packer->ptr);
   } else {
     // Nil error
-    mpack_nil(&packer.ptr);
+    mpack_nil(&packer->ptr);
     // Return value
-    mpack_object(arg, &packer);
+    mpack_object(arg, packer);
   }
 
-  packer_buffer_finish_channels(&packer);
+  if (packer == &buf) {
+    packer_buffer_finish_channels(packer);
+  }
 
   log_response(SEND, channel->id, ERROR_SET(err) ? ERR : RES, response_id);
 }
@@ -665,6 +701,41 @@ static void channel_flush_callback(PackerBuffer *packer)
   packer_buffer_init_channels(packer->anydata, (size_t)packer->anyint, packer);
 }
 
+/// Starts collecting responses on `channel`, see parse_msgpack().
+static void rpc_batch_init(Channel *channel)
+{
+  Channel *chan = channel;
+  // Pending UI data must be written before the responses.
+  packer_buffer_init_channels(&chan, 1, &channel->rpc.batch);
+  channel->rpc.batch.packer_flush = rpc_batch_flush_callback;
+  channel->rpc.batch.anydata = channel;
+}
+
+/// Writes the responses collected on `channel`, if any.
+static void rpc_batch_write(Channel *channel)
+{
+  PackerBuffer *batch = &channel->rpc.batch;
+  if (batch->startptr == NULL) {
+    return;
+  }
+
+  char *data = batch->startptr;
+  size_t len = (size_t)(batch->ptr - batch->startptr);
+  *batch = (PackerBuffer){ 0 };
+  if (len > 0) {
+    channel_write(channel, wstream_new_buffer(data, len, 1, free_block));
+  } else {
+    free_block(data);
+  }
+}
+
+static void rpc_batch_flush_callback(PackerBuffer *packer)
+{
+  Channel *channel = packer->anydata;
+  rpc_batch_write(channel);
+  rpc_batch_init(channel);
+}
+
 void rpc_set_client_info(uint64_t id, Dict info)
 {
   Channel *chan = find_rpc_channel(id);
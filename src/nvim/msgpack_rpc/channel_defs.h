@@ -5,6 +5,7 @@
 
 #include "nvim/api/private/dispatch.h"
 #include "nvim/map_defs.h"
+#include "nvim/msgpack_rpc/packer_defs.h"
 #include "nvim/ui_defs.h"
 
 typedef struct Channel Channel;
@@ -44,4 +45,6 @@ typedef struct {
   kvec_t(ChannelCallFrame *) call_stack;
   Dict info;
   ClientType client_type;
+  bool batching;  ///< collect responses in `batch` while parsing received data
+  PackerBuffer batch;  ///< responses not yet written, startptr is NULL when empty
 } RpcState;
@@ -584,6 +584,21 @@ int os_open_stdin_fd(void)
   return stdin_dup_fd;
 }
 
+/// Tell the kernel that a file will be read sequentially from start to end
+///
+/// This only is a hint: it makes read-ahead more aggressive where supported and
+/// is a no-op elsewhere. Errors are ignored.
+///
+/// @param[in]  fd  File descriptor of the file.
+void os_fadvise_sequential(const int fd)
+{
+#ifdef HAVE_POSIX_FADVISE
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+  (void)fd;
+#endif
+}
+
 /// Read from a file
 ///
 /// Handles EINTR, but not other errors.
@@ -691,6 +706,50 @@ ptrdiff_t os_readv(const int fd, bool *const ret_eof, struct iovec *iov, size_t
   }
   return (ptrdiff_t)read_bytes;
 }
+
+/// Write to a file from multiple buffers at once
+///
+/// Wrapper for writev().
+///
+/// @param[in]  fd  File descriptor to write to.
+/// @param[in]  iov  Description of buffers to write. Note: this description
+///                  may change, it is incorrect to use data it points to after
+///                  os_writev().
+/// @param[in]  iov_size  Number of buffers in iov.
+///
+/// @return Number of bytes written or libuv error code (< 0).
+ptrdiff_t os_writev(const int fd, struct iovec *iov, size_t iov_size)
+  FUNC_ATTR_NONNULL_ALL
+{
+  size_t written_bytes = 0;
+  while (iov_size) {
+    ptrdiff_t cur_written_bytes = writev(fd, iov, (int)iov_size);
+    if (cur_written_bytes < 0) {
+      const int error = os_translate_sys_error(errno);
+      errno = 0;
+      if (error == UV_EINTR || error == UV_EAGAIN) {
+        continue;
+      }
+      return (ptrdiff_t)error;
+    }
+    if (cur_written_bytes == 0) {
+      break;
+    }
+    written_bytes += (size_t)cur_written_bytes;
+    while (iov_size && cur_written_bytes) {
+      if (cur_written_bytes < (ptrdiff_t)iov->iov_len) {
+        iov->iov_len -= (size_t)cur_written_bytes;
+        iov->iov_base = (char *)iov->iov_base + cur_written_bytes;
+        cur_written_bytes = 0;
+      } else {
+        cur_written_bytes -= (ptrdiff_t)iov->iov_len;
+        iov_size--;
+        iov++;
+      }
+    }
+  }
+  return (ptrdiff_t)written_bytes;
+}
 #endif  // HAVE_READV
 
 /// Write to a file
@@ -60,6 +60,8 @@
 #include "nvim/option_defs.h"
 #include "nvim/option_vars.h"
 #include "nvim/optionstr.h"
+#include "nvim/os/fileio.h"
+#include "nvim/os/fileio_defs.h"
 #include "nvim/os/fs.h"
 #include "nvim/os/fs_defs.h"
 #include "nvim/os/input.h"
@@ -249,6 +251,9 @@ typedef struct {
   bool valid;
 } qffields_T;
 
+/// Size of the blocks read by vgr_file_may_match().
+#define VGR_READ_SIZE 0x10000
+
 /// :vimgrep command arguments
 typedef struct {
   int tomatch;          ///< maximum number of matches to find
@@ -5496,6 +5501,83 @@ static buf_T *vgr_load_dummy_buf(char *fname, char *dirname_start, char *dirname
   return buf;
 }
 
+/// Whether loading "fname" may run autocommands that change the text read
+/// from the file, such as decompressing it.
+static bool vgr_read_autocmds(char *fname)
+{
+  static const event_T events[] = { EVENT_BUFREADCMD, EVENT_BUFREADPRE, EVENT_BUFREADPOST };
+
+  if (is_autocmd_blocked()) {
+    return false;
+  }
+  for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+    if (!event_ignored(events[i], p_ei) && has_autocmd(events[i], fname, NULL)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Check whether file "fname" may contain a match for "prog" without loading
+/// it in a buffer: look for the plain text any match must contain in the
+/// bytes of the file.
+///
+/// @return  false only when the file certainly has no match.
+static bool vgr_file_may_match(const char *fname, const regprog_T *prog, bool ic)
+{
+  const char *texts[8];
+  size_t lens[8];
+  const size_t count = vim_regprog_must_texts(prog, ic, texts, lens, ARRAY_SIZE(texts));
+  if (count == 0 || *p_ccv != NUL) {
+    return true;
+  }
+  size_t maxlen = 0;
+  for (size_t i = 0; i < count; i++) {
+    maxlen = MAX(maxlen, lens[i]);
+  }
+
+  FileDescriptor fp;
+  if (file_open(&fp, fname, kFileReadOnly, 0) != 0) {
+    return true;  // Loading the file gives the error.
+  }
+
+  char *buf = xmalloc(VGR_READ_SIZE + maxlen);
+  size_t keep = 0;  // bytes kept from the previous block
+  bool found = false;
+  while (!found) {
+    const ptrdiff_t n = file_read(&fp, buf + keep, VGR_READ_SIZE);
+    if (n <= 0) {
+      found = n < 0;
+      break;
+    }
+    if (memchr(buf + keep, NUL, (size_t)n) != NULL) {
+      // Probably UTF-16 or UTF-32, the text does not appear as ASCII.
+      found = true;
+      break;
+    }
+    const size_t size = keep + (size_t)n;
+    for (size_t i = 0; i < count && !found; i++) {
+      for (const char *p = buf; (size_t)(p - buf) + lens[i] <= size; p++) {
+        p = memchr(p, texts[i][0], size - (size_t)(p - buf));
+        if (p == NULL || (size_t)(p - buf) + lens[i] > size) {
+          break;
+        }
+        if (memcmp(p, texts[i], lens[i]) == 0) {
+          found = true;
+          break;
+        }
+      }
+    }
+    // Keep the end of the block, a text may continue in the next one.
+    keep = MIN(size, maxlen - 1);
+    memmove(buf, buf + size - keep, keep);
+  }
+
+  file_close(&fp, false);
+  xfree(buf);
+  return found;
+}
+
 /// Check whether a quickfix/location list is valid. Autocmds may remove or
 /// change a quickfix list when vimgrep is running. If the list is not found,
 /// create a new list.
@@ -5578,7 +5660,7 @@ static bool vgr_match_buflines(qf_list_T *qfl, char *fname, buf_T *buf, char *sp
 
       // Fuzzy string match
       CLEAR_FIELD(matches);
-      while (fuzzy_match(str + col, spat, false, &score, matches, (int)sz) > 0) {
+      while (fuzzy_match(str + col, spat, false, &score, matches, (int)sz, NULL) > 0) {
         // Pass the buffer number so that it gets used even for a
         // dummy buffer, unless duplicate_name is set, then the
         // buffer will be wiped out below.
@@ -5726,6 +5808,15 @@ static int vgr_process_files(win_T *wp, qf_info_T *qi, vgr_args_T *cmd_args, boo
     }
 
     buf_T *buf = buflist_findname_exp(cmd_args->fnames[fi]);
+    if (buf == NULL
+        && !(cmd_args->flags & VGR_FUZZY)
+        && !vgr_read_autocmds(fname)
+        && !vgr_file_may_match(cmd_args->fnames[fi], cmd_args->regmatch.regprog,
+                               cmd_args->regmatch.rmm_ic)) {
+      // No need to load the file in a buffer, it can't have a match.
+      continue;
+    }
+
     bool using_dummy;
     if (buf == NULL || buf->b_ml.ml_mfp == NULL) {
       // Remember that a buffer with this name already exists.
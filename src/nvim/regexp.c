@@ -29,6 +29,7 @@
 #include "nvim/globals.h"
 #include "nvim/keycodes.h"
 #include "nvim/macros_defs.h"
+#include "nvim/map_defs.h"
 #include "nvim/mark.h"
 #include "nvim/mark_defs.h"
 #include "nvim/mbyte.h"
@@ -38,6 +39,7 @@
 #include "nvim/message.h"
 #include "nvim/option_vars.h"
 #include "nvim/os/input.h"
+#include "nvim/os/time.h"
 #include "nvim/plines.h"
 #include "nvim/pos_defs.h"
 #include "nvim/profile.h"
@@ -81,19 +83,32 @@ struct regprog {
   unsigned regflags;
   unsigned re_engine;  ///< Automatic, backtracking or NFA engine.
   unsigned re_flags;   ///< Second argument for vim_regcomp().
+  unsigned re_p_re;    ///< 'regexpengine' when compiled
+  bool re_cpo_lit;     ///< 'l' was in 'cpoptions' when compiled
   bool re_in_use;      ///< prog is being executed
+  RegexpStats *re_stats;  ///< counters for the pattern, or NULL
 };
 
+/// Patterns with their cost counters, see regexp_stats_iter().
+static PMap(cstr_t) regexp_stats_map = MAP_INIT;
+/// Count the cost of matching for patterns compiled while this is set.
+static bool regexp_profiling = false;
+/// Number of NFA states and backtracking items visited so far.
+static int64_t regexp_steps = 0;
+
 /// Structure used by the back track matcher.
 /// These fields are only to be used in regexp.c!
 /// See regexp.c for an explanation.
 typedef struct {
-  // These four members implement regprog_T.
+  // These members implement regprog_T.
   regengine_T *engine;
   unsigned regflags;
   unsigned re_engine;
   unsigned re_flags;
+  unsigned re_p_re;
+  bool re_cpo_lit;
   bool re_in_use;
+  RegexpStats *re_stats;
 
   int regstart;
   uint8_t reganch;
@@ -120,18 +135,24 @@ struct nfa_state {
 
 /// Structure used by the NFA matcher.
 typedef struct {
-  // These four members implement regprog_T.
+  // These members implement regprog_T.
   regengine_T *engine;
   unsigned regflags;
   unsigned re_engine;
   unsigned re_flags;
+  unsigned re_p_re;
+  bool re_cpo_lit;
   bool re_in_use;
+  RegexpStats *re_stats;
 
   nfa_state_T *start;   ///< points into state[]
 
   int reganch;          ///< pattern starts with ^
   int regstart;         ///< char at start of pattern
   uint8_t *match_text;  ///< plain text to match with
+  uint8_t *start_texts;  ///< texts a match starts with, "foo\0bar\0\0", or NULL
+  bool has_firstbytes;  ///< firstbytes[] is valid
+  uint8_t firstbytes[32];  ///< bitmap of the ASCII bytes a match can start with
 
   int has_zend;         ///< pattern contains \ze
   int has_backref;      ///< pattern contains \1 .. \9
@@ -580,6 +601,7 @@ static void init_class_tab(void)
 #define RF_HASNL    4   // can match a NL
 #define RF_ICOMBINE 8   // ignore combining characters
 #define RF_LOOKBH   16  // uses "\@<=" or "\@<!"
+#define RF_POSDEP   32  // uses the cursor, Visual area, a mark, line or column
 
 // Global work variables for vim_regcomp().
 
@@ -662,6 +684,14 @@ int re_multiline(const regprog_T *prog)
   return prog->regflags & RF_HASNL;
 }
 
+// Return true if what compiled regular expression "prog" matches depends on
+// the cursor, the Visual area, a mark or the line or column number.
+bool re_posdep(const regprog_T *prog)
+  FUNC_ATTR_NONNULL_ALL
+{
+  return prog->regflags & RF_POSDEP;
+}
+
 // Check for an equivalence class name "[=a=]".  "pp" points to the '['.
 // Returns a character representing the class. Zero means that no item was
 // recognized.  Otherwise "pp" is advanced to after the item.
@@ -1604,8 +1634,9 @@ static int match_with_backref(linenr_T start_lnum, colnr_T start_col, linenr_T e
   }
   while (true) {
     // Since getting one line may invalidate the other, need to make copy.
-    // Slow!
-    if (rex.line != reg_tofree) {
+    // Slow!  Not needed when comparing with the same line, getting it again
+    // returns the same pointer.
+    if (clnum != rex.lnum && rex.line != reg_tofree) {
       len = (int)strlen((char *)rex.line);
       if (reg_tofree == NULL || len >= (int)reg_tofreelen) {
         len += 50;              // get some extra
@@ -1846,6 +1877,13 @@ static inline char *cstrchr(const char *const s, const int c)
     return vim_strchr(s, c);
   }
 
+  // Only U+017F and U+212A fold to an ASCII letter ("s" and "k"), for other
+  // ASCII letters it is enough to look for the bytes of both cases.
+  if (c < 0x80 && lc != 's' && lc != 'k') {
+    const char both[3] = { (char)c, (char)cc, NUL };
+    return strpbrk(s, both);
+  }
+
   for (const char *p = s; *p != NUL; p += utfc_ptr2len(p)) {
     const int uc = utf_ptr2char(p);
     if (c > 0x80 || uc > 0x80) {
@@ -4520,10 +4558,12 @@ static uint8_t *regatom(int *flagp)
         return FAIL;
       }
       ret = regnode(CURSOR);
+      regflags |= RF_POSDEP;
       break;
 
     case 'V':
       ret = regnode(RE_VISUAL);
+      regflags |= RF_POSDEP;
       break;
 
     case 'C':
@@ -4658,6 +4698,7 @@ static uint8_t *regatom(int *flagp)
           // "\%'m", "\%<'m" and "\%>'m": Mark
           c = getchr();
           ret = regnode(RE_MARK);
+          regflags |= RF_POSDEP;
           if (ret == JUST_CALC_SIZE) {
             regsize += 2;
           } else {
@@ -4693,6 +4734,7 @@ static uint8_t *regatom(int *flagp)
             }
             ret = regnode(RE_VCOL);
           }
+          regflags |= RF_POSDEP;
           if (ret == JUST_CALC_SIZE) {
             regsize += 5;
           } else {
@@ -6183,6 +6225,7 @@ static bool regmatch(uint8_t *scan, const proftime_T *tm, int *timed_out)
         status = RA_FAIL;
         break;
       }
+      regexp_steps++;
       // Check for timeout once in a 100 times to avoid overhead.
       if (tm != NULL && ++tm_count == 100) {
         tm_count = 0;
@@ -8759,6 +8802,218 @@ static int nfa_get_regstart(nfa_state_T *start, int depth)
   return 0;
 }
 
+// Figure out the set of ASCII characters a match must start with, when the
+// first character of every alternative is a plain ASCII character.  This
+// catches "foo\|bar" where nfa_get_regstart() finds nothing.
+// Adds the characters to the bitmap "set" and returns true when it worked.
+static bool nfa_get_firstbytes(nfa_state_T *start, int depth, uint8_t *set)
+{
+  nfa_state_T *p = start;
+
+  if (depth > 8) {
+    return false;
+  }
+
+  while (p != NULL) {
+    switch (p->c) {
+    // all kinds of zero-width matches
+    case NFA_BOL:
+    case NFA_BOF:
+    case NFA_BOW:
+    case NFA_EOW:
+    case NFA_ZSTART:
+    case NFA_ZEND:
+    case NFA_CURSOR:
+    case NFA_VISUAL:
+    case NFA_LNUM:
+    case NFA_LNUM_GT:
+    case NFA_LNUM_LT:
+    case NFA_COL:
+    case NFA_COL_GT:
+    case NFA_COL_LT:
+    case NFA_VCOL:
+    case NFA_VCOL_GT:
+    case NFA_VCOL_LT:
+    case NFA_MARK:
+    case NFA_MARK_GT:
+    case NFA_MARK_LT:
+
+    case NFA_MOPEN:
+    case NFA_MOPEN1:
+    case NFA_MOPEN2:
+    case NFA_MOPEN3:
+    case NFA_MOPEN4:
+    case NFA_MOPEN5:
+    case NFA_MOPEN6:
+    case NFA_MOPEN7:
+    case NFA_MOPEN8:
+    case NFA_MOPEN9:
+    case NFA_NOPEN:
+    case NFA_ZOPEN:
+    case NFA_ZOPEN1:
+    case NFA_ZOPEN2:
+    case NFA_ZOPEN3:
+    case NFA_ZOPEN4:
+    case NFA_ZOPEN5:
+    case NFA_ZOPEN6:
+    case NFA_ZOPEN7:
+    case NFA_ZOPEN8:
+    case NFA_ZOPEN9:
+      p = p->out;
+      break;
+
+    case NFA_SPLIT:
+      return nfa_get_firstbytes(p->out, depth + 1, set)
+             && nfa_get_firstbytes(p->out1, depth + 1, set);
+
+    default:
+      // Only ASCII: it is never part of a multibyte or composing character,
+      // thus skipping to it always lands on the start of a character.
+      if (p->c > 0 && p->c < 0x80) {
+        set[p->c >> 3] |= (uint8_t)(1 << (p->c & 7));
+        return true;
+      }
+      return false;
+    }
+  }
+  return false;
+}
+
+#define NFA_START_TEXT_MAXLEN 32    ///< max length of a text in start_texts
+#define NFA_START_TEXT_MAXCOUNT 8   ///< max number of texts in start_texts
+
+// Add to "gap" the ASCII text each alternative of the NFA state list must
+// start with.  Returns false when an alternative does not start with at least
+// two plain ASCII characters or there are too many alternatives.
+static bool nfa_collect_start_texts(nfa_state_T *start, int depth, garray_T *gap, int *count)
+{
+  nfa_state_T *p = start;
+  char text[NFA_START_TEXT_MAXLEN + 1];
+  int len = 0;
+
+  if (depth > 4) {
+    return false;
+  }
+
+  while (p != NULL) {
+    switch (p->c) {
+    // all kinds of zero-width matches
+    case NFA_BOL:
+    case NFA_BOF:
+    case NFA_BOW:
+    case NFA_EOW:
+    case NFA_ZSTART:
+    case NFA_ZEND:
+    case NFA_CURSOR:
+    case NFA_VISUAL:
+    case NFA_LNUM:
+    case NFA_LNUM_GT:
+    case NFA_LNUM_LT:
+    case NFA_COL:
+    case NFA_COL_GT:
+    case NFA_COL_LT:
+    case NFA_VCOL:
+    case NFA_VCOL_GT:
+    case NFA_VCOL_LT:
+    case NFA_MARK:
+    case NFA_MARK_GT:
+    case NFA_MARK_LT:
+
+    case NFA_MOPEN:
+    case NFA_MOPEN1:
+    case NFA_MOPEN2:
+    case NFA_MOPEN3:
+    case NFA_MOPEN4:
+    case NFA_MOPEN5:
+    case NFA_MOPEN6:
+    case NFA_MOPEN7:
+    case NFA_MOPEN8:
+    case NFA_MOPEN9:
+    case NFA_NOPEN:
+    case NFA_ZOPEN:
+    case NFA_ZOPEN1:
+    case NFA_ZOPEN2:
+    case NFA_ZOPEN3:
+    case NFA_ZOPEN4:
+    case NFA_ZOPEN5:
+    case NFA_ZOPEN6:
+    case NFA_ZOPEN7:
+    case NFA_ZOPEN8:
+    case NFA_ZOPEN9:
+    case NFA_MCLOSE:
+    case NFA_MCLOSE1:
+    case NFA_MCLOSE2:
+    case NFA_MCLOSE3:
+    case NFA_MCLOSE4:
+    case NFA_MCLOSE5:
+    case NFA_MCLOSE6:
+    case NFA_MCLOSE7:
+    case NFA_MCLOSE8:
+    case NFA_MCLOSE9:
+    case NFA_NCLOSE:
+    case NFA_ZCLOSE:
+    case NFA_ZCLOSE1:
+    case NFA_ZCLOSE2:
+    case NFA_ZCLOSE3:
+    case NFA_ZCLOSE4:
+    case NFA_ZCLOSE5:
+    case NFA_ZCLOSE6:
+    case NFA_ZCLOSE7:
+    case NFA_ZCLOSE8:
+    case NFA_ZCLOSE9:
+      p = p->out;
+      break;
+
+    case NFA_SPLIT:
+      if (len > 0) {
+        goto done;
+      }
+      // "a\|b\|c" is a chain of splits on "out1", follow it in this loop so
+      // that the depth only limits nesting.
+      if (!nfa_collect_start_texts(p->out, depth + 1, gap, count)) {
+        return false;
+      }
+      p = p->out1;
+      break;
+
+    default:
+      if (p->c > 0 && p->c < 0x80 && len < NFA_START_TEXT_MAXLEN) {
+        text[len++] = (char)p->c;
+        p = p->out;
+        break;
+      }
+      goto done;
+    }
+  }
+
+done:
+  if (len < 2 || *count >= NFA_START_TEXT_MAXCOUNT) {
+    return false;
+  }
+  ga_concat_len(gap, text, (size_t)len);
+  ga_append(gap, NUL);
+  (*count)++;
+  return true;
+}
+
+// Figure out the texts that a match must start with, one for each
+// alternative, such as "foo", "bar" and "baz" for "foo\|bar\|baz".
+// A line that contains none of them cannot have a match.
+// Returns them in allocated memory as "foo\0bar\0baz\0\0", or NULL.
+static uint8_t *nfa_get_start_texts(nfa_state_T *start)
+{
+  garray_T ga;
+  int count = 0;
+
+  ga_init(&ga, 1, 32);
+  if (!nfa_collect_start_texts(start, 0, &ga, &count)) {
+    ga_clear(&ga);
+    return NULL;
+  }
+  ga_append(&ga, NUL);
+  return ga.ga_data;
+}
+
 // Figure out if the NFA state list contains just literal text and nothing
 // else.  If so return a string in allocated memory with what must match after
 // regstart.  Otherwise return NULL.
@@ -10325,10 +10580,12 @@ static int nfa_regatom(void)
         return FAIL;
       }
       EMIT(NFA_CURSOR);
+      regflags |= RF_POSDEP;
       break;
 
     case 'V':
       EMIT(NFA_VISUAL);
+      regflags |= RF_POSDEP;
       break;
 
     case 'C':
@@ -10435,12 +10692,14 @@ static int nfa_regatom(void)
           return FAIL;
         }
         EMIT((int)n);
+        regflags |= RF_POSDEP;
         break;
       } else if (no_Magic(c) == '\'' && n == 0) {
         // \%'m  \%<'m  \%>'m
         EMIT(cmp == '<' ? NFA_MARK_LT
                         : cmp == '>' ? NFA_MARK_GT : NFA_MARK);
         EMIT(getchr());
+        regflags |= RF_POSDEP;
         break;
       }
     }
@@ -14080,6 +14339,29 @@ static int failure_chance(nfa_state_T *state, int depth)
   return 50;
 }
 
+// Skip to the first of the texts in "texts" (as made by nfa_get_start_texts())
+// that appears in the line at or after "*colp".
+static int skip_to_start_texts(const uint8_t *texts, colnr_T *colp)
+{
+  const char *const from = (char *)rex.line + *colp;
+  const char *first = NULL;
+
+  for (const char *text = (char *)texts; *text != NUL; text += strlen(text) + 1) {
+    const char *s = strstr(from, text);
+    if (s != NULL && (first == NULL || s < first)) {
+      first = s;
+    }
+  }
+  if (first == NULL) {
+    return FAIL;
+  }
+  *colp = (colnr_T)(first - (char *)rex.line);
+  return OK;
+}
+
+// Whether byte "b" may be the first byte of a match of "prog".
+#define NFA_FIRSTBYTE(prog, b) ((prog)->firstbytes[(b) >> 3] & (1 << ((b) & 7)))
+
 // Skip until the char "c" we know a match must start with.
 static int skip_to_start(int c, colnr_T *colp)
 {
@@ -14091,6 +14373,22 @@ static int skip_to_start(int c, colnr_T *colp)
   return OK;
 }
 
+// Skip until a byte in the "firstbytes" bitmap of "prog".
+// Only to be used when rex.reg_ic is false, the bitmap does not include the
+// case-folded characters.
+static int skip_to_firstbyte(const nfa_regprog_T *prog, colnr_T *colp)
+{
+  const uint8_t *s = rex.line + *colp;
+  while (*s != NUL && !NFA_FIRSTBYTE(prog, *s)) {
+    s++;
+  }
+  if (*s == NUL) {
+    return FAIL;
+  }
+  *colp = (colnr_T)(s - rex.line);
+  return OK;
+}
+
 // Check for a match with match_text.
 // Called after skip_to_start() has found regstart.
 // Returns zero for no match, 1 for a match.
@@ -14343,6 +14641,7 @@ static int nfa_regmatch(nfa_regprog_T *prog, nfa_state_T *start, regsubs_T *subm
         }
       }
       t = &thislist->t[listidx];
+      regexp_steps++;
 
 #ifdef NFA_REGEXP_DEBUG_LOG
       nfa_set_code(t->state->c);
@@ -15508,6 +15807,17 @@ static int nfa_regmatch(nfa_regprog_T *prog, nfa_state_T *start, regsubs_T *subm
               add = false;
             }
           }
+        } else if (prog->has_firstbytes && !rex.reg_ic && clen != 0) {
+          // Same as above, for a set of possible start characters.
+          if (nextlist->n == 0) {
+            colnr_T col = (colnr_T)(rex.input - rex.line) + clen;
+            if (skip_to_firstbyte(prog, &col) == FAIL) {
+              break;
+            }
+            rex.input = rex.line + col - clen;
+          } else if (!NFA_FIRSTBYTE(prog, rex.input[clen])) {
+            add = false;
+          }
         }
 
         if (add) {
@@ -15814,6 +16124,14 @@ static int nfa_regexec_both(uint8_t *line, colnr_T startcol, proftime_T *tm, int
     rex.need_clear_zsubexpr = false;
   }
 
+  if (prog->start_texts != NULL && !rex.reg_ic && !rex.reg_icombine) {
+    // Skip ahead to where one of the texts a match starts with appears.
+    // When none appears in the line there is no match.
+    if (skip_to_start_texts(prog->start_texts, &col) == FAIL) {
+      return 0L;
+    }
+  }
+
   if (prog->regstart != NUL) {
     // Skip ahead until a character we know the match must start with.
     // When there is none there is no match.
@@ -15832,6 +16150,11 @@ static int nfa_regexec_both(uint8_t *line, colnr_T startcol, proftime_T *tm, int
       }
       return retval;
     }
+  } else if (prog->has_firstbytes && !rex.reg_ic) {
+    // Skip ahead to a character any match must start with.
+    if (skip_to_firstbyte(prog, &col) == FAIL) {
+      return 0L;
+    }
   }
 
   // If the start column is past the maximum column: no need to try.
@@ -15954,6 +16277,10 @@ static regprog_T *nfa_regcomp(uint8_t *expr, int re_flags)
   prog->reganch = nfa_get_reganch(prog->start, 0);
   prog->regstart = nfa_get_regstart(prog->start, 0);
   prog->match_text = nfa_get_match_text(prog->start);
+  prog->start_texts = nfa_get_start_texts(prog->start);
+  memset(prog->firstbytes, 0, sizeof(prog->firstbytes));
+  prog->has_firstbytes = prog->regstart == NUL
+                         && nfa_get_firstbytes(prog->start, 0, prog->firstbytes);
 
 #ifdef REGEXP_DEBUG
   nfa_postfix_dump(expr, OK);
@@ -15989,6 +16316,7 @@ static void nfa_regfree(regprog_T *prog)
   }
 
   xfree(((nfa_regprog_T *)prog)->match_text);
+  xfree(((nfa_regprog_T *)prog)->start_texts);
   xfree(((nfa_regprog_T *)prog)->pattern);
   xfree(((nfa_regprog_T *)prog)->listbuf[0]);
   xfree(((nfa_regprog_T *)prog)->listbuf[1]);
@@ -16173,6 +16501,9 @@ regprog_T *vim_regcomp(const char *expr_arg, int re_flags)
     // to be very slow when executing it.
     prog->re_engine = (unsigned)regexp_engine;
     prog->re_flags = (unsigned)re_flags;
+    prog->re_p_re = (unsigned)p_re;
+    prog->re_cpo_lit = reg_cpo_lit;
+    prog->re_stats = regexp_profiling ? regexp_stats_get(expr_arg) : NULL;
   }
 
   return prog;
@@ -16186,6 +16517,150 @@ void vim_regfree(regprog_T *prog)
   }
 }
 
+/// Get the plain texts of which at least one appears in any text that "prog"
+/// matches.  Only ASCII texts are returned, they appear as-is in a file with
+/// an ASCII compatible encoding.
+///
+/// @param ic  'ignorecase' is used, the text may appear in another case.
+/// @param[out] texts  pointers to the texts, not NUL terminated, valid as long
+///                    as "prog"
+/// @param[out] lens  lengths of the texts
+/// @param maxcount  size of "texts" and "lens"
+///
+/// @return  the number of texts, zero when there are none or they can't be
+///          found out.
+size_t vim_regprog_must_texts(const regprog_T *prog, bool ic, const char **texts, size_t *lens,
+                              size_t maxcount)
+  FUNC_ATTR_NONNULL_ALL
+{
+  if (ic || (prog->regflags & (RF_ICASE | RF_ICOMBINE))) {
+    return 0;
+  }
+
+  size_t count = 0;
+  if (prog->engine == &nfa_regengine) {
+    const nfa_regprog_T *nprog = (const nfa_regprog_T *)prog;
+    if (nprog->start_texts == NULL) {
+      return 0;
+    }
+    for (const char *text = (char *)nprog->start_texts; *text != NUL;
+         text += strlen(text) + 1) {
+      if (count == maxcount) {
+        return 0;
+      }
+      texts[count] = text;
+      lens[count] = strlen(text);
+      count++;
+    }
+  } else {
+    const bt_regprog_T *bprog = (const bt_regprog_T *)prog;
+    if (bprog->regmust == NULL || bprog->regmlen == 0 || maxcount == 0) {
+      return 0;
+    }
+    for (int i = 0; i < bprog->regmlen; i++) {
+      if (bprog->regmust[i] >= 0x80) {
+        return 0;
+      }
+    }
+    texts[0] = (char *)bprog->regmust;
+    lens[0] = (size_t)bprog->regmlen;
+    count = 1;
+  }
+  return count;
+}
+
+/// Number of programs kept by vim_regfree_cached().
+#define REGPROG_CACHE_SIZE 16
+
+/// Compiled programs given back with vim_regfree_cached(), for reuse by
+/// vim_regcomp_cached().  A program is taken out of the cache while it is
+/// used, thus it is never used twice at the same time.
+static struct {
+  char *pattern;       ///< pattern as passed to vim_regcomp()
+  int re_flags;        ///< "re_flags" as passed to vim_regcomp()
+  int engine;          ///< 'regexpengine' when compiled
+  bool cpo_lit;        ///< 'l' was in 'cpoptions' when compiled
+  regprog_T *prog;     ///< NULL for an unused entry
+  uint64_t last_used;  ///< for dropping the least recently used entry
+} regprog_cache[REGPROG_CACHE_SIZE];
+static uint64_t regprog_cache_tick = 0;
+
+/// Whether the compiled program of "expr" only depends on the pattern, the
+/// flags, 'regexpengine' and 'cpoptions'.  "~" uses the previous substitute
+/// string and character classes like [:keyword:] use the buffer options.
+static bool regprog_cacheable(const char *expr)
+{
+  return strchr(expr, '~') == NULL && strstr(expr, "[:") == NULL;
+}
+
+/// Like vim_regcomp(), but reuses a program that was given back with
+/// vim_regfree_cached() for the same pattern and flags.
+/// The result must be given back with vim_regfree_cached() or freed with
+/// vim_regfree().
+regprog_T *vim_regcomp_cached(const char *expr, int re_flags)
+{
+  if (regprog_cacheable(expr)) {
+    const bool cpo_lit = vim_strchr(p_cpo, kCpoLiteral) != NULL;
+    for (int i = 0; i < REGPROG_CACHE_SIZE; i++) {
+      if (regprog_cache[i].prog != NULL
+          && regprog_cache[i].re_flags == re_flags
+          && regprog_cache[i].engine == p_re
+          && regprog_cache[i].cpo_lit == cpo_lit
+          && strcmp(regprog_cache[i].pattern, expr) == 0) {
+        regprog_T *prog = regprog_cache[i].prog;
+        regprog_cache[i].prog = NULL;
+        XFREE_CLEAR(regprog_cache[i].pattern);
+        g_stats.regexp_cache_hit++;
+        if (regexp_profiling && prog->re_stats == NULL) {
+          prog->re_stats = regexp_stats_get(expr);
+        }
+        return prog;
+      }
+    }
+  }
+  g_stats.regexp_cache_miss++;
+  return vim_regcomp(expr, re_flags);
+}
+
+/// Give back a program obtained with vim_regcomp_cached() for pattern
+/// "expr".  It is kept for reuse, dropping the least recently used program
+/// when the cache is full.
+void vim_regfree_cached(regprog_T *prog, const char *expr)
+{
+  if (prog == NULL) {
+    return;
+  }
+  // 'regexpengine' and 'cpoptions' may have been changed while the program
+  // was used, it must only be found with the values it was compiled with.
+  // "\%.l" and similar items put the cursor position in the program.
+  if (!regprog_cacheable(expr) || re_posdep(prog)
+      || (int)prog->re_p_re != p_re
+      || prog->re_cpo_lit != (vim_strchr(p_cpo, kCpoLiteral) != NULL)) {
+    vim_regfree(prog);
+    return;
+  }
+
+  int idx = 0;
+  for (int i = 0; i < REGPROG_CACHE_SIZE; i++) {
+    if (regprog_cache[i].prog == NULL) {
+      idx = i;
+      break;
+    }
+    if (regprog_cache[i].last_used < regprog_cache[idx].last_used) {
+      idx = i;
+    }
+  }
+  vim_regfree(regprog_cache[idx].prog);
+  xfree(regprog_cache[idx].pattern);
+
+  regprog_cache[idx].pattern = xstrdup(expr);
+  regprog_cache[idx].re_flags = (int)prog->re_flags;
+  regprog_cache[idx].engine = (int)prog->re_p_re;
+  regprog_cache[idx].cpo_lit = prog->re_cpo_lit;
+  regprog_cache[idx].prog = prog;
+  regprog_cache[idx].last_used = ++regprog_cache_tick;
+}
+
 #ifdef EXITFREE
 void free_regexp_stuff(void)
 {
@@ -16193,10 +16668,73 @@ void free_regexp_stuff(void)
   ga_clear(&backpos);
   xfree(reg_tofree);
   xfree(reg_prev_sub);
+  for (int i = 0; i < REGPROG_CACHE_SIZE; i++) {
+    vim_regfree(regprog_cache[i].prog);
+    xfree(regprog_cache[i].pattern);
+  }
+  const char *key;
+  RegexpStats *stats;
+  map_foreach(&regexp_stats_map, key, stats, {
+    xfree((char *)key);
+    xfree(stats);
+  });
+  map_destroy(cstr_t, &regexp_stats_map);
 }
 
 #endif
 
+/// Get the counters for pattern "expr", adding them when needed.
+static RegexpStats *regexp_stats_get(const char *expr)
+{
+  cstr_t *key;
+  bool new_item = false;
+  RegexpStats **ref = (RegexpStats **)pmap_put_ref(cstr_t)(&regexp_stats_map, expr, &key,
+                                                         &new_item);
+  if (new_item) {
+    *key = xstrdup(expr);
+    *ref = xcalloc(1, sizeof(RegexpStats));
+  }
+  return *ref;
+}
+
+/// Enable or disable counting the cost of matching.  Only patterns compiled
+/// (or taken from the cache) while enabled are counted.
+void regexp_profile_set(bool enable)
+{
+  regexp_profiling = enable;
+}
+
+/// Reset the counters of all patterns to zero.
+void regexp_stats_clear(void)
+{
+  RegexpStats *stats;
+  map_foreach_value(&regexp_stats_map, stats, {
+    CLEAR_POINTER(stats);
+  });
+}
+
+/// Iterate over the patterns that were matched and their cost counters.
+///
+/// @param[in,out]  iter     Position in the list of patterns, 0 to start.
+/// @param[out]     pattern  The pattern.
+/// @param[out]     stats    The counters of the pattern.
+///
+/// @return false when there are no more patterns.
+bool regexp_stats_iter(size_t *const iter, const char **const pattern,
+                       const RegexpStats **const stats)
+  FUNC_ATTR_NONNULL_ALL
+{
+  while (*iter < regexp_stats_map.set.h.n_keys) {
+    const size_t i = (*iter)++;
+    if (regexp_stats_map.values[i]->calls > 0) {
+      *pattern = regexp_stats_map.set.keys[i];
+      *stats = regexp_stats_map.values[i];
+      return true;
+    }
+  }
+  return false;
+}
+
 static void report_re_switch(const char *pat)
 {
   if (p_verbose > 0) {
@@ -16242,6 +16780,10 @@ static bool vim_regexec_string(regmatch_T *rmp, const char *line, colnr_T col, b
   rex.reg_startpos = NULL;
   rex.reg_endpos = NULL;
 
+  RegexpStats *const stats = regexp_profiling ? rmp->regprog->re_stats : NULL;
+  const uint64_t start_time = stats != NULL ? os_hrtime() : 0;
+  const int64_t start_steps = regexp_steps;
+
   int result = rmp->regprog->engine->regexec_nl(rmp, (uint8_t *)line, col, nl);
   rmp->regprog->re_in_use = false;
 
@@ -16261,16 +16803,27 @@ static bool vim_regexec_string(regmatch_T *rmp, const char *line, colnr_T col, b
       // previous one to avoid "regprog" becoming NULL.
       rmp->regprog = prev_prog;
     } else {
+      rmp->regprog->re_stats = prev_prog->re_stats;
+      rmp->regprog->re_p_re = prev_prog->re_p_re;
       vim_regfree(prev_prog);
       rmp->regprog->re_in_use = true;
       result = rmp->regprog->engine->regexec_nl(rmp, (uint8_t *)line, col, nl);
       rmp->regprog->re_in_use = false;
     }
+    if (stats != NULL) {
+      stats->switches++;
+    }
 
     xfree(pat);
     p_re = save_p_re;
   }
 
+  if (stats != NULL) {
+    stats->calls++;
+    stats->time += os_hrtime() - start_time;
+    stats->steps += regexp_steps - start_steps;
+  }
+
   rex_in_use = rex_in_use_save;
   if (rex_in_use) {
     rex = rex_save;
@@ -16338,6 +16891,11 @@ int vim_regexec_multi(regmmatch_T *rmp, win_T *win, buf_T *buf, linenr_T lnum, c
   }
   rex_in_use = true;
 
+  RegexpStats *const stats = regexp_profiling ? rmp->regprog->re_stats : NULL;
+  const uint64_t start_time = stats != NULL ? os_hrtime() : 0;
+  const int64_t start_steps = regexp_steps;
+  const bool was_timed_out = timed_out != NULL && *timed_out;
+
   int result = rmp->regprog->engine->regexec_multi(rmp, win, buf, lnum, col, tm, timed_out);
   rmp->regprog->re_in_use = false;
 
@@ -16363,17 +16921,31 @@ int vim_regexec_multi(regmmatch_T *rmp, win_T *win, buf_T *buf, linenr_T lnum, c
       // previous one to avoid "regprog" becoming NULL.
       rmp->regprog = prev_prog;
     } else {
+      rmp->regprog->re_stats = prev_prog->re_stats;
+      rmp->regprog->re_p_re = prev_prog->re_p_re;
       vim_regfree(prev_prog);
 
       rmp->regprog->re_in_use = true;
       result = rmp->regprog->engine->regexec_multi(rmp, win, buf, lnum, col, tm, timed_out);
       rmp->regprog->re_in_use = false;
     }
+    if (stats != NULL) {
+      stats->switches++;
+    }
 
     xfree(pat);
     p_re = save_p_re;
   }
 
+  if (stats != NULL) {
+    stats->calls++;
+    stats->time += os_hrtime() - start_time;
+    stats->steps += regexp_steps - start_steps;
+    if (!was_timed_out && timed_out != NULL && *timed_out) {
+      stats->timeouts++;
+    }
+  }
+
   rex_in_use = rex_in_use_save;
   if (rex_in_use) {
     rex = rex_save;
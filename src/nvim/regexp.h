@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>  // IWYU pragma: keep
+
 #include "nvim/eval/typval_defs.h"  // IWYU pragma: keep
 #include "nvim/pos_defs.h"  // IWYU pragma: keep
 #include "nvim/regexp_defs.h"  // IWYU pragma: keep
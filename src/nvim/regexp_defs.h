@@ -64,6 +64,15 @@ typedef struct {
   bool rm_ic;
 } regmatch_T;
 
+/// Cost of matching a pattern, counted when regexp profiling is enabled.
+typedef struct {
+  int64_t calls;     ///< number of times matching was done
+  uint64_t time;     ///< nanoseconds spent matching
+  int64_t steps;     ///< NFA states or backtracking items visited
+  int64_t switches;  ///< switched from the NFA to the backtracking engine
+  int64_t timeouts;  ///< matching stopped at the time limit
+} RegexpStats;
+
 /// Structure used to store external references: "\z\(\)" to "\z\1".
 /// Use a reference count to avoid the need to copy this around.  When it goes
 /// from 1 to zero the matches need to be freed.
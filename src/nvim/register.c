@@ -2052,7 +2052,7 @@ void do_put(int regname, yankreg_T *reg, int dir, int count, int flags)
           STRCPY(newp, y_array[y_size - 1].data);
           STRCPY(newp + totlen, ptr);
           // insert second line
-          ml_append(lnum, newp, 0, false);
+          ml_append(lnum, newp, (colnr_T)(ptrlen + totlen + 1), false);
           new_lnum++;
           xfree(newp);
 
@@ -2070,7 +2070,7 @@ void do_put(int regname, yankreg_T *reg, int dir, int count, int flags)
 
         for (; i < y_size; i++) {
           if ((y_type != kMTCharWise || i < y_size - 1)) {
-            if (ml_append(lnum, y_array[i].data, 0, false) == FAIL) {
+            if (ml_append(lnum, y_array[i].data, (colnr_T)y_array[i].size + 1, false) == FAIL) {
               goto error;
             }
             new_lnum++;
@@ -35,6 +35,7 @@
 #include "nvim/indent_c.h"
 #include "nvim/input.h"
 #include "nvim/insexpand.h"
+#include "nvim/klib/kvec.h"
 #include "nvim/macros_defs.h"
 #include "nvim/mark.h"
 #include "nvim/mark_defs.h"
@@ -122,6 +123,37 @@ static bool saved_spats_no_hlsearch = false;
 static char *mr_pattern = NULL;
 static size_t mr_patternlen = 0;
 
+/// Start of a match counted by update_search_stat().
+typedef struct {
+  pos_T start;   ///< start of the match
+  pos_T maxend;  ///< largest end of this match and all earlier matches
+} SearchStatMatch;
+
+/// Maximum number of matches kept in "search_stat_index".
+#define SEARCH_STAT_INDEX_MAX 0x40000
+
+/// All matches of the last search pattern in a buffer, kept when
+/// update_search_stat() counted every match.  While the buffer, the pattern
+/// and the options used for matching are unchanged, the count for any cursor
+/// position is found here instead of searching the buffer again.
+/// Not used for patterns that depend on the cursor, the Visual area, marks or
+/// line and column numbers.
+static struct {
+  kvec_t(SearchStatMatch) matches;
+  handle_T buf;             ///< buffer handle, 0 when not valid
+  varnumber_T changedtick;  ///< b:changedtick when the matches were found
+  char *pat;                ///< pattern, allocated
+  size_t patlen;
+  int magic;                ///< 'magic'
+  int ic;                   ///< 'ignorecase'
+  int scs;                  ///< 'smartcase'
+  bool no_scs;              ///< "no_scs" of the pattern
+  char *isk;                ///< 'iskeyword', allocated
+  char *isi;                ///< 'isident', allocated
+  char *isf;                ///< 'isfname', allocated
+  char *isp;                ///< 'isprint', allocated
+} search_stat_index;
+
 // Type used by find_pattern_in_path() to remember which included files have
 // been searched already.
 typedef struct {
@@ -298,6 +330,13 @@ void free_search_patterns(void)
 
   XFREE_CLEAR(mr_pattern);
   mr_patternlen = 0;
+
+  kv_destroy(search_stat_index.matches);
+  XFREE_CLEAR(search_stat_index.pat);
+  XFREE_CLEAR(search_stat_index.isk);
+  XFREE_CLEAR(search_stat_index.isi);
+  XFREE_CLEAR(search_stat_index.isf);
+  XFREE_CLEAR(search_stat_index.isp);
 }
 
 #endif
@@ -609,6 +648,9 @@ int searchit(win_T *win, buf_T *buf, pos_T *pos, pos_T *end_pos, Direction dir,
     }
     return FAIL;
   }
+  if (extra_arg != NULL) {
+    extra_arg->sa_posdep = re_posdep(regmatch.regprog);
+  }
 
   const bool search_from_match_end = vim_strchr(p_cpo, kCpoSearch) != NULL;
 
@@ -2769,17 +2811,33 @@ static void update_search_stat(int dirc, pos_T *pos, pos_T *cursor_pos, searchst
   if (equalpos(lastpos, *cursor_pos) && !wraparound
       && (dirc == 0 || dirc == '/' ? cur < cnt : cur > 1)) {
     cur += dirc == 0 ? 0 : dirc == '/' ? 1 : -1;
+  } else if (search_stat_index_valid()) {
+    search_stat_index_lookup(p, maxcount, &cur, &cnt, &exact_match, &incomplete);
+    if (cnt > 0) {
+      xfree(lastpat);
+      lastpat = xstrnsave(spats[last_idx].pat, spats[last_idx].patlen);
+      lastpatlen = spats[last_idx].patlen;
+      chgtick = (int)buf_get_changedtick(curbuf);
+      lbuf = curbuf;
+      lastpos = p;
+    }
   } else {
     proftime_T start;
     bool done_search = false;
     pos_T endpos = { 0, 0, 0 };
+    // Only when counting from the start all matches can be remembered.
+    bool collect = EMPTY_POS(lastpos);
+    searchit_arg_T sia;
+    CLEAR_FIELD(sia);
+    kv_size(search_stat_index.matches) = 0;
+    search_stat_index.buf = 0;
     p_ws = false;
     if (timeout > 0) {
       start = profile_setlimit(timeout);
     }
     while (!got_int && searchit(curwin, curbuf, &lastpos, &endpos,
                                 FORWARD, NULL, 0, 1, SEARCH_KEEP, RE_LAST,
-                                p_magic, NULL) != FAIL) {
+                                p_magic, &sia) != FAIL) {
       done_search = true;
       // Stop after passing the time limit.
       if (timeout > 0 && profile_passed_limit(start)) {
@@ -2793,12 +2851,29 @@ static void update_search_stat(int dirc, pos_T *pos, pos_T *cursor_pos, searchst
           exact_match = true;
         }
       }
+      if (collect) {
+        if (kv_size(search_stat_index.matches) >= SEARCH_STAT_INDEX_MAX) {
+          collect = false;
+        } else {
+          SearchStatMatch m = { lastpos, endpos };
+          if (kv_size(search_stat_index.matches) > 0
+              && lt(endpos, kv_last(search_stat_index.matches).maxend)) {
+            m.maxend = kv_last(search_stat_index.matches).maxend;
+          }
+          kv_push(search_stat_index.matches, m);
+        }
+      }
       fast_breakcheck();
       if (maxcount > 0 && cnt > maxcount) {
         incomplete = 2;    // max count exceeded
         break;
       }
     }
+    // Not for patterns whose matches depend on the cursor position.
+    if (collect && incomplete == 0 && !got_int
+        && kv_size(search_stat_index.matches) > 0 && !sia.sa_posdep) {
+      search_stat_index_set();
+    }
     if (got_int) {
       cur = -1;  // abort
     }
@@ -2819,6 +2894,80 @@ static void update_search_stat(int dirc, pos_T *pos, pos_T *cursor_pos, searchst
   p_ws = save_ws;
 }
 
+/// @return  true when "search_stat_index" has the matches of the last search
+///          pattern in the current buffer.
+static bool search_stat_index_valid(void)
+{
+  return search_stat_index.buf == curbuf->handle
+         && search_stat_index.changedtick == buf_get_changedtick(curbuf)
+         && search_stat_index.magic == p_magic
+         && search_stat_index.ic == p_ic
+         && search_stat_index.scs == p_scs
+         && search_stat_index.no_scs == spats[last_idx].no_scs
+         && strcmp(search_stat_index.isk, curbuf->b_p_isk) == 0
+         && strcmp(search_stat_index.isi, p_isi) == 0
+         && strcmp(search_stat_index.isf, p_isf) == 0
+         && strcmp(search_stat_index.isp, p_isp) == 0
+         && spats[last_idx].pat != NULL
+         && search_stat_index.patlen == spats[last_idx].patlen
+         && memcmp(search_stat_index.pat, spats[last_idx].pat,
+                   search_stat_index.patlen) == 0;
+}
+
+/// Remember that "search_stat_index" has all matches of the last search
+/// pattern in the current buffer.
+static void search_stat_index_set(void)
+{
+  xfree(search_stat_index.pat);
+  search_stat_index.pat = xmemdupz(spats[last_idx].pat, spats[last_idx].patlen);
+  search_stat_index.patlen = spats[last_idx].patlen;
+  search_stat_index.buf = curbuf->handle;
+  search_stat_index.changedtick = buf_get_changedtick(curbuf);
+  search_stat_index.magic = p_magic;
+  search_stat_index.ic = p_ic;
+  search_stat_index.scs = p_scs;
+  search_stat_index.no_scs = spats[last_idx].no_scs;
+  xfree(search_stat_index.isk);
+  search_stat_index.isk = xstrdup(curbuf->b_p_isk);
+  xfree(search_stat_index.isi);
+  search_stat_index.isi = xstrdup(p_isi);
+  xfree(search_stat_index.isf);
+  search_stat_index.isf = xstrdup(p_isf);
+  xfree(search_stat_index.isp);
+  search_stat_index.isp = xstrdup(p_isp);
+}
+
+/// Compute the search count for position "p" from "search_stat_index", with
+/// the same result as counting the matches with searchit().
+static void search_stat_index_lookup(pos_T p, int maxcount, int *cur, int *cnt,
+                                     bool *exact_match, int *incomplete)
+{
+  size_t total = kv_size(search_stat_index.matches);
+  size_t limit = total;
+  *incomplete = 0;
+  if (maxcount > 0 && total > (size_t)maxcount) {
+    // Counting stops at the first match after "maxcount".
+    limit = (size_t)maxcount + 1;
+    *incomplete = 2;
+  }
+
+  // Find the number of matches that start at or before "p".
+  size_t lo = 0;
+  size_t hi = limit;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (ltoreq(kv_A(search_stat_index.matches, mid).start, p)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  *cur = (int)lo;
+  *cnt = (int)limit;
+  *exact_match = lo > 0 && lt(p, kv_A(search_stat_index.matches, lo - 1).maxend);
+}
+
 // "searchcount()" function
 void f_searchcount(typval_T *argvars, typval_T *rettv, EvalFuncData fptr)
 {
@@ -95,6 +95,8 @@ typedef struct {
   proftime_T *sa_tm;        ///< timeout limit or NULL
   int sa_timed_out;  ///< set when timed out
   int sa_wrapped;    ///< search wrapped around
+  bool sa_posdep;    ///< set when the pattern depends on the cursor position,
+                     ///< see re_posdep()
 } searchit_arg_T;
 
 typedef struct {
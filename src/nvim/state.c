@@ -24,6 +24,7 @@
 #include "nvim/option.h"
 #include "nvim/option_vars.h"
 #include "nvim/os/input.h"
+#include "nvim/os/time.h"
 #include "nvim/state.h"
 #include "nvim/strings.h"
 #include "nvim/types_defs.h"
@@ -31,6 +32,10 @@
 
 #include "state.c.generated.h"
 
+/// Time (ms) spent on queued events after which state_handle_k_event() returns
+/// even when more events are queued, so that the screen is updated.
+#define K_EVENT_TIME_SLICE 20
+
 void state_enter(VimState *s)
   FUNC_ATTR_NONNULL_ALL
 {
@@ -112,6 +117,7 @@ getkey:
 /// otherwise bursts of events can block break checking indefinitely.
 void state_handle_k_event(void)
 {
+  uint64_t start = os_hrtime();
   while (true) {
     Event event = multiqueue_get(main_loop.events);
     if (event.handler) {
@@ -127,7 +133,8 @@ void state_handle_k_event(void)
     // TODO(bfredl): as an further micro-optimization, we could check whether
     // event.handler already checked input.
     os_breakcheck();
-    if (input_available() || got_int) {
+    if (input_available() || got_int
+        || os_hrtime() - start >= K_EVENT_TIME_SLICE * 1000000) {
       return;
     }
   }
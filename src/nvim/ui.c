@@ -479,6 +479,7 @@ void ui_line(ScreenGrid *grid, int row, bool invalid_row, int startcol, int endc
 
   size_t off = grid->line_offset[row] + (size_t)startcol;
 
+  remote_ui_line_cache_clear();
   ui_call_raw_line(grid->handle, row, startcol, endcol, clearcol, clearattr,
                    flags, (const schar_T *)grid->chars + off,
                    (const sattr_T *)grid->attrs + off);
@@ -13,6 +13,7 @@
 
 #include "klib/kvec.h"
 #include "nvim/api/private/defs.h"
+#include "nvim/api/ui.h"
 #include "nvim/ascii_defs.h"
 #include "nvim/buffer_defs.h"
 #include "nvim/globals.h"
@@ -490,6 +491,7 @@ static void compose_line(Integer row, Integer startcol, Integer endcol, LineFlag
       }
     }
   }
+  remote_ui_line_cache_clear();
   ui_composed_call_raw_line(1, row, startcol + skipstart,
                             endcol - skipend, endcol - skipend, 0, flags,
                             (const schar_T *)linebuf + skipstart,
@@ -512,6 +514,7 @@ static void compose_debug(Integer startrow, Integer endrow, Integer startcol, In
   }
 
   for (int row = (int)startrow; row < endrow; row++) {
+    remote_ui_line_cache_clear();
     ui_composed_call_raw_line(1, row, startcol, startcol, endcol, attr, false,
                               (const schar_T *)linebuf,
                               (const sattr_T *)attrbuf);
@@ -604,6 +607,7 @@ void ui_comp_raw_line(Integer grid, Integer row, Integer startcol, Integer endco
       assert(attrs[i] >= 0);
     }
 #endif
+    remote_ui_line_cache_clear();
     ui_composed_call_raw_line(1, row, startcol, endcol, clearcol, clearattr,
                               flags, chunk, attrs);
   }
@@ -141,8 +141,14 @@ typedef struct {
   buf_T *bi_buf;
   FILE *bi_fp;
   off_T bi_fsize;  ///< Size of `bi_fp` when reading, 0 if unknown.
+  off_T bi_pos;    ///< Number of bytes read from `bi_fp` so far.
 } bufinfo_T;
 
+/// Size of the stdio buffer used for reading and writing an undo file.
+/// Each line is read and written as a length and a string, a big buffer
+/// keeps that from turning into many small system calls.
+#define UNDO_IOBUFSIZE 0x10000
+
 #include "undo.c.generated.h"
 
 static const char e_undo_list_corrupt[]
@@ -1291,6 +1297,7 @@ void u_write_undo(const char *const name, const bool forceit, buf_T *const buf,
     os_remove(file_name);
     goto theend;
   }
+  setvbuf(fp, NULL, _IOFBF, UNDO_IOBUFSIZE);
 
   // Undo must be synced.
   u_sync(true);
@@ -1454,6 +1461,8 @@ void u_read_undo(char *name, const uint8_t *hash, const char *orig_name FUNC_ATT
     }
     goto error;
   }
+  setvbuf(fp, NULL, _IOFBF, UNDO_IOBUFSIZE);
+  os_fadvise_sequential(fileno(fp));
 
   FileInfo file_info;
   bufinfo_T bi = {
@@ -1464,12 +1473,12 @@ void u_read_undo(char *name, const uint8_t *hash, const char *orig_name FUNC_ATT
 
   // Read the undo file header.
   char magic_buf[UF_START_MAGIC_LEN];
-  if (fread(magic_buf, UF_START_MAGIC_LEN, 1, fp) != 1
+  if (!undo_read(&bi, (uint8_t *)magic_buf, UF_START_MAGIC_LEN)
       || memcmp(magic_buf, UF_START_MAGIC, UF_START_MAGIC_LEN) != 0) {
     semsg(_("E823: Not an undo file: %s"), file_name);
     goto error;
   }
-  int version = get2c(fp);
+  int version = undo_read_2c(&bi);
   if (version != UF_VERSION) {
     semsg(_("E824: Incompatible undo file: %s"), file_name);
     goto error;
@@ -1745,6 +1754,7 @@ static void put_header_ptr(bufinfo_T *bi, u_header_T *uhp)
 
 static int undo_read_4c(bufinfo_T *bi)
 {
+  bi->bi_pos += 4;
   return get4c(bi->bi_fp);
 }
 
@@ -1757,8 +1767,9 @@ static int undo_read_len(bufinfo_T *bi, const char *what, const char *file_name)
   FUNC_ATTR_NONNULL_ALL
 {
   int len = undo_read_4c(bi);
-  off_T pos = vim_ftell(bi->bi_fp);
-  if (len < 0 || (bi->bi_fsize > 0 && (pos < 0 || len > bi->bi_fsize - pos))) {
+  // Use the counted position, vim_ftell() may do a system call for every line.
+  off_T pos = bi->bi_pos;
+  if (len < 0 || (bi->bi_fsize > 0 && len > bi->bi_fsize - pos)) {
     // get4c() also returns -1 for a file that ends here.
     corruption_error(feof(bi->bi_fp) ? "truncated" : what, file_name);
     return -1;
@@ -1768,16 +1779,19 @@ static int undo_read_len(bufinfo_T *bi, const char *what, const char *file_name)
 
 static int undo_read_2c(bufinfo_T *bi)
 {
+  bi->bi_pos += 2;
   return get2c(bi->bi_fp);
 }
 
 static int undo_read_byte(bufinfo_T *bi)
 {
+  bi->bi_pos++;
   return getc(bi->bi_fp);
 }
 
 static time_t undo_read_time(bufinfo_T *bi)
 {
+  bi->bi_pos += 8;
   return get8ctime(bi->bi_fp);
 }
 
@@ -1791,6 +1805,7 @@ static time_t undo_read_time(bufinfo_T *bi)
 static bool undo_read(bufinfo_T *bi, uint8_t *buffer, size_t size)
   FUNC_ATTR_NONNULL_ARG(1)
 {
+  bi->bi_pos += (off_T)size;
   const bool retval = fread(buffer, size, 1, bi->bi_fp) == 1;
   if (!retval) {
     // Error may be checked for only later.  Fill with zeros,
@@ -3040,6 +3055,49 @@ void u_clearall(buf_T *buf)
   buf->b_u_line_lnum = 0;
 }
 
+/// Count the memory used by the undo tree of buffer "buf": headers,
+/// entries, the saved lines and the extmark undo objects.
+///
+/// Walks the whole tree, only meant for statistics.
+size_t u_mem_used(buf_T *buf)
+  FUNC_ATTR_NONNULL_ALL
+{
+  size_t total = 0;
+  int mark = ++lastmark;
+  u_header_T *uhp = buf->b_u_oldhead;
+  while (uhp != NULL) {
+    if (uhp->uh_walk != mark) {
+      uhp->uh_walk = mark;
+      total += sizeof(u_header_T) + kv_max(uhp->uh_extmark) * sizeof(ExtmarkUndoObject);
+      for (u_entry_T *uep = uhp->uh_entry; uep != NULL; uep = uep->ue_next) {
+        total += sizeof(u_entry_T) + (size_t)uep->ue_size * sizeof(char *);
+        for (int i = 0; i < uep->ue_size; i++) {
+          total += strlen(uep->ue_array[i]) + 1;
+        }
+      }
+    }
+
+    // Walk through the tree like u_write_undo() does.
+    if (uhp->uh_prev.ptr != NULL && uhp->uh_prev.ptr->uh_walk != mark) {
+      uhp = uhp->uh_prev.ptr;
+    } else if (uhp->uh_alt_next.ptr != NULL
+               && uhp->uh_alt_next.ptr->uh_walk != mark) {
+      uhp = uhp->uh_alt_next.ptr;
+    } else if (uhp->uh_next.ptr != NULL && uhp->uh_alt_prev.ptr == NULL
+               && uhp->uh_next.ptr->uh_walk != mark) {
+      uhp = uhp->uh_next.ptr;
+    } else if (uhp->uh_alt_prev.ptr != NULL) {
+      uhp = uhp->uh_alt_prev.ptr;
+    } else {
+      uhp = uhp->uh_next.ptr;
+    }
+  }
+  if (buf->b_u_line_ptr != NULL) {
+    total += strlen(buf->b_u_line_ptr) + 1;
+  }
+  return total;
+}
+
 /// Free all allocated memory blocks for the buffer 'buf'.
 void u_blockfree(buf_T *buf)
 {
@@ -3138,11 +3196,15 @@ static char *u_save_line(linenr_T lnum)
 
 /// Allocate memory and copy line into it
 ///
+/// The length is known from the memline, no need to scan the line for the
+/// NUL as xstrdup() would.
+///
 /// @param lnum line to copy
 /// @param buf buffer to copy from
 static char *u_save_line_buf(buf_T *buf, linenr_T lnum)
 {
-  return xstrdup(ml_get_buf(buf, lnum));
+  colnr_T len = ml_get_buf_len(buf, lnum);
+  return xmemdupz(ml_get_buf(buf, lnum), (size_t)len);
 }
 
 /// Check if the 'modified' flag is set, or 'ff' has changed (only need to
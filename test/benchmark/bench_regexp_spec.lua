@@ -64,3 +64,38 @@ describe('regexp search', function()
     command('write')
   end)
 end)
+
+describe('regexp alternation on long lines', function()
+  local lines = 2000
+  local pattern = [[quux\|frob\|zork]]
+
+  setup(function()
+    clear()
+  end)
+
+  local function bench(regexpengine)
+    command('enew!')
+    command('set regexpengine=' .. regexpengine)
+    -- Long lines where only the last word matches.
+    n.exec_lua(function(count)
+      local line = ('lorem ipsum dolor sit amet '):rep(40) .. 'zork'
+      local l = {}
+      for i = 1, count do
+        l[i] = line
+      end
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, l)
+    end, lines)
+    local ms = n.exec_lua(function(pat)
+      local start = vim.uv.hrtime()
+      vim.cmd('silent %s/' .. pat .. '//gn')
+      return (vim.uv.hrtime() - start) / 1e6
+    end, pattern)
+    print(('\nre=%d: %s on %d lines: %.2f ms'):format(regexpengine, pattern, lines, ms))
+  end
+
+  for _, regexpengine in ipairs({ 0, 1, 2 }) do
+    it('regexpengine=' .. regexpengine, function()
+      bench(regexpengine)
+    end)
+  end
+end)
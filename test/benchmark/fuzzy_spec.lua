@@ -0,0 +1,38 @@
+local n = require('test.functional.testnvim')()
+local t = require('test.testutil')
+local describe, it = t.describe, t.it
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('matchfuzzy() performance', function()
+  it('100000 file names', function()
+    clear()
+    local stats = {}
+    local ms = 1 / 1000000
+
+    exec_lua(function()
+      local names = {}
+      for i = 1, 100000 do
+        names[i] = ('src/module%d/sub_dir%d/file_name_%d.c'):format(i % 97, i % 13, i)
+      end
+      _G.names = names
+    end)
+
+    for _, query in ipairs({ 'fnc', 'mod1sub', 'xyz', 'module42/file_name_4' }) do
+      local elapsed = exec_lua(function(q)
+        local start = vim.uv.hrtime()
+        for _ = 1, 5 do
+          vim.fn.matchfuzzy(_G.names, q)
+        end
+        return vim.uv.hrtime() - start
+      end, query)
+
+      table.insert(stats, elapsed)
+      io.stdout:write(('\n%-24s%14.6f ms'):format(query, elapsed * ms))
+      io.stdout:flush()
+    end
+    io.stdout:write('\n')
+
+    t.bench_report(stats, { unit = 'ms' })
+  end)
+end)
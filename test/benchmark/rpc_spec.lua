@@ -0,0 +1,83 @@
+local n = require('test.functional.testnvim')()
+local t = require('test.testutil')
+local describe, it, before_each, after_each = t.describe, t.it, t.before_each, t.after_each
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('pipelined RPC requests', function()
+  local count = 10000
+
+  before_each(function()
+    clear()
+    exec_lua(function(nvim_prog)
+      local uv = vim.uv
+      local stdin, stdout = assert(uv.new_pipe()), assert(uv.new_pipe())
+      _G.proc = uv.spawn(nvim_prog, {
+        args = { '--clean', '-n', '--embed', '--headless' },
+        stdio = { stdin, stdout },
+      }, function() end)
+      _G.stdin, _G.stdout = stdin, stdout
+
+      local session = vim.mpack.Session()
+      local pack = vim.mpack.Packer()
+      _G.received = 0
+      stdout:read_start(function(_, data)
+        local pos = 1
+        while data and pos <= #data do
+          local type
+          type, _, _, _, pos = session:receive(data, pos)
+          if type == 'response' then
+            _G.received = _G.received + 1
+          end
+        end
+      end)
+
+      --- Writes `c` requests at once and waits for all responses.
+      function _G.pipeline(method, args, c)
+        local chunks = {}
+        for i = 1, c do
+          chunks[i] = session:request(function() end) .. pack(method) .. pack(args)
+        end
+        local target = _G.received + c
+        local start = uv.hrtime()
+        stdin:write(table.concat(chunks))
+        assert(vim.wait(60000, function()
+          return _G.received >= target
+        end, 1))
+        return uv.hrtime() - start
+      end
+
+      -- Wait until the server is up.
+      _G.pipeline('nvim_buf_line_count', { 0 }, 1)
+    end, n.nvim_prog)
+  end)
+
+  after_each(function()
+    exec_lua(function()
+      _G.stdout:read_stop()
+      _G.proc:kill('sigkill')
+      _G.proc:close()
+      _G.stdin:close()
+      _G.stdout:close()
+    end)
+  end)
+
+  local function bench(method, args)
+    local stats = {}
+    for _ = 1, 5 do
+      local elapsed = exec_lua(function()
+        return _G.pipeline(method, args, count)
+      end)
+      table.insert(stats, elapsed)
+    end
+    t.bench_report(stats, { unit = 'ms' })
+  end
+
+  it(('%d fast requests (nvim_replace_termcodes)'):format(count), function()
+    bench('nvim_replace_termcodes', { '<CR>', true, true, true })
+  end)
+
+  it(('%d requests (nvim_buf_line_count)'):format(count), function()
+    bench('nvim_buf_line_count', { 0 })
+  end)
+end)
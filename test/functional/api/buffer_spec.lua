@@ -2318,6 +2318,45 @@ describe('api/buf', function()
       eq(0, get_offset(0, 0))
       eq(5, get_offset(0, 1))
     end)
+
+    it('stays correct with edits and lookups all over a big buffer', function()
+      eq(
+        true,
+        exec_lua(function()
+          local lines = {}
+          for i = 1, 5000 do
+            lines[i] = ('x'):rep(i % 17)
+          end
+          vim.api.nvim_buf_set_lines(0, 0, -1, true, lines)
+          local function check()
+            local off = 0
+            for i = 0, #lines do
+              if vim.api.nvim_buf_get_offset(0, i) ~= off then
+                return false
+              end
+              if i > 0 and i < #lines and vim.fn.byte2line(off + 1) ~= i + 1 then
+                return false
+              end
+              off = off + #(lines[i + 1] or '') + 1
+            end
+            return true
+          end
+          -- Alternate lookups far apart with edits before and after them.
+          for _, lnum in ipairs({ 4000, 10, 2500, 4400, 1, 3000 }) do
+            vim.api.nvim_buf_get_offset(0, 4500)
+            vim.api.nvim_buf_set_lines(0, lnum - 1, lnum, true, { 'changed', 'added' })
+            table.remove(lines, lnum)
+            table.insert(lines, lnum, 'added')
+            table.insert(lines, lnum, 'changed')
+            vim.api.nvim_buf_get_offset(0, 200)
+            vim.api.nvim_buf_set_lines(0, lnum + 500, lnum + 502, false, {})
+            table.remove(lines, lnum + 501)
+            table.remove(lines, lnum + 501)
+          end
+          return check()
+        end)
+      )
+    end)
   end)
 
   describe('nvim_buf_get_var, nvim_buf_set_var, nvim_buf_del_var', function()
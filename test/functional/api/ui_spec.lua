@@ -242,6 +242,34 @@ describe('UI event channels', function()
     eq('…\nVimLeave\nUILeave\nUILeave\n', t.read_file('Xevents.log'))
   end)
 
+  it('draws changed lines on several UIs', function()
+    clear()
+    local screen = Screen.new(30, 4)
+    local session2 = n.connect(api.nvim_get_vvar('servername'))
+    local screen2 = Screen.new(30, 4, nil, session2)
+
+    -- Redraws the same row with new cells each time.
+    feed('ifoo<Esc>')
+    feed('Abar<Esc>')
+    local expected = [[
+      fooba^r                        |
+      {1:~                             }|*2
+                                    |
+    ]]
+    screen:expect(expected)
+    screen2:expect(expected)
+
+    feed('xx')
+    expected = [[
+      foo^b                          |
+      {1:~                             }|*2
+                                    |
+    ]]
+    screen:expect(expected)
+    screen2:expect(expected)
+    session2:close()
+  end)
+
   it('sets chan for TermResponse and filters tty requests', function()
     clear()
     local main_chan = api.nvim_get_chan_info(0).id
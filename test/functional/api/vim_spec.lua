@@ -4444,6 +4444,28 @@ describe('API', function()
     end)
   end)
 
+  describe('nvim__regexp_stats', function()
+    it('counts the cost of matching per pattern', function()
+      eq(0, vim.tbl_count(api.nvim__regexp_stats({ enable = true })))
+      api.nvim_buf_set_lines(0, 0, -1, true, { 'foo', 'bar', 'foo bar' })
+      command('%s/bar/baz/')
+      eq(5, fn.match('abc foo', 'o\\+'))
+
+      local stats = api.nvim__regexp_stats({ clear = true })
+      eq(1, stats['o\\+'].calls)
+      ok(stats['bar'].calls >= 3)
+      ok(stats['bar'].steps > 0)
+      eq(0, stats['bar'].switches)
+      eq(0, stats['bar'].timeouts)
+
+      -- Cleared counters are not reported.
+      eq(0, vim.tbl_count(api.nvim__regexp_stats({ enable = false })))
+      -- Not counted after disabling.
+      command('%s/foo/x/')
+      eq(0, vim.tbl_count(api.nvim__regexp_stats({})))
+    end)
+  end)
+
   describe('nvim_del_mark', function()
     it('works', function()
       local buf = api.nvim_create_buf(false, true)
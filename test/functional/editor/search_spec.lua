@@ -5,6 +5,7 @@ local describe, it, before_each = t.describe, t.it, t.before_each
 local clear = n.clear
 local command = n.command
 local eq = t.eq
+local fn = n.fn
 local pcall_err = t.pcall_err
 
 describe('search (/)', function()
@@ -14,4 +15,126 @@ describe('search (/)', function()
     eq([[Vim:E951: \% value too large]], pcall_err(command, '/\\v%18446744071562067968c'))
     eq([[Vim:E951: \% value too large]], pcall_err(command, '/\\v%2147483648c'))
   end)
+
+  it('alternatives with literal starts match like the backtracking engine', function()
+    local patterns = {
+      [[foo\|bar\|baz]],
+      [[\<\(foo\|bar\)\>]],
+      [[\cfoo\|BAR]],
+      [[x\zsfoo\|bar]],
+      [[a\|b\|]],
+      [[\(x\|y\)\+z]],
+      [[\(ab\|cd\)ef\|gh.]],
+      [[^foo\|^bar]],
+      [[\Zab\|cd]],
+      [[aa1\|bb2\|cc3\|dd4\|ee5\|ff6\|gg7]],
+      [[aa1\|bb2\|cc3\|dd4\|ee5\|ff6\|gg7\|hh8]],
+      [[aa1\|bb2\|cc3\|dd4\|ee5\|ff6\|gg7\|hh8\|ii9]],
+      [[aa1\|\(bb2\|cc3\)\|dd4\|ee5\|ff6\|gg7\|hh8]],
+    }
+    local texts = {
+      '',
+      'nothing here',
+      'a foobar Baz BAR baz',
+      'äöü bar€ fOo xfoo',
+      'yyxyz',
+      'ab cdef abef gh',
+      'bar foo',
+      'a\u{301}b cd',
+      'xx gg7 ff6',
+      'only hh8',
+      'ii9 then hh8',
+    }
+    for _, pat in ipairs(patterns) do
+      for _, text in ipairs(texts) do
+        for _, ic in ipairs({ false, true }) do
+          command('set ' .. (ic and 'ignorecase' or 'noignorecase'))
+          command('set regexpengine=1')
+          local expected = fn.matchstrpos(text, pat, 0, 2)
+          command('set regexpengine=2')
+          eq(expected, fn.matchstrpos(text, pat, 0, 2), ('%s ~ %s'):format(text, pat))
+        end
+      end
+    end
+  end)
+
+  it('backreferences in the same line and in the next line', function()
+    fn.setline(1, { 'xabab', 'foo', 'foo bar', 'barbar', 'aXa' })
+    for re = 1, 2 do
+      command('set regexpengine=' .. re)
+      eq({ 1, 2 }, fn.searchpos([[\(ab\)\1]], 'nw'))
+      eq({ 2, 1 }, fn.searchpos([[\(foo\)\n\1]], 'nw'))
+      eq({ 3, 5 }, fn.searchpos([[\(bar\)\n\1\1]], 'nw'))
+      eq({ 5, 1 }, fn.searchpos([[\c\(a\)x\1]], 'nw'))
+      eq({ 0, 0 }, fn.searchpos([[\(bar\)\n\1\1x]], 'nw'))
+    end
+  end)
+
+  it('ignores case for characters that fold to ASCII', function()
+    -- U+017F folds to "s", U+212A (Kelvin sign) folds to "k".
+    fn.setline(1, { 'xx\u{17F}', 'a\u{212A}b', 'AKB SS' })
+    for re = 1, 2 do
+      command('set regexpengine=' .. re)
+      eq({ 1, 2 }, fn.searchpos([[\cX]], 'nw'))
+      eq({ 2, 5 }, fn.searchpos([[\cB]], 'nw'))
+      eq({ 3, 3 }, fn.searchpos([[\cb s]], 'nw'))
+      eq({ 3, 2 }, fn.searchpos([[\CK]], 'nw'))
+    end
+    command('set regexpengine=2')
+    eq({ 1, 3 }, fn.searchpos([[\cS]], 'nw'))
+    eq({ 2, 2 }, fn.searchpos([[\ck]], 'nw'))
+  end)
+
+  it('searchcount() gives the same result when the matches are remembered', function()
+    fn.setline(1, { 'foo bar foo', 'xx', 'foofoo', 'abcd' })
+    local function count(pat, pos, maxcount)
+      local r = fn.searchcount({ pattern = pat, pos = pos, maxcount = maxcount or 0 })
+      return { r.current, r.total, r.exact_match, r.incomplete }
+    end
+    -- The first call counts all matches, the second one finds them remembered.
+    for _ = 1, 2 do
+      eq({ 1, 4, 1, 0 }, count('foo', { 1, 1, 0 }))
+      eq({ 2, 4, 0, 0 }, count('foo', { 2, 1, 0 }))
+      eq({ 4, 4, 1, 0 }, count('foo', { 3, 5, 0 }))
+      eq({ 4, 4, 0, 0 }, count('foo', { 4, 1, 0 }))
+      eq({ 3, 3, 0, 2 }, count('foo', { 3, 5, 0 }, 2))
+      -- One match more than "maxcount" is incomplete.
+      eq({ 4, 4, 0, 2 }, count('foo', { 4, 1, 0 }, 3))
+      eq({ 4, 4, 0, 0 }, count('foo', { 4, 1, 0 }, 4))
+      -- "c" matches inside "abcd", the cursor is only in the first match.
+      eq({ 2, 2, 1, 0 }, count([[abcd\|c]], { 4, 4, 0 }))
+    end
+    -- A change in the buffer or options is noticed.
+    fn.setline(2, 'foo')
+    eq({ 3, 5, 1, 0 }, count('foo', { 2, 1, 0 }))
+    fn.setline(4, 'FOO')
+    eq({ 5, 5, 0, 0 }, count('foo', { 4, 1, 0 }))
+    command('set ignorecase')
+    eq({ 6, 6, 1, 0 }, count('foo', { 4, 1, 0 }))
+  end)
+
+  it('searchcount() counts again when the cursor or options change', function()
+    fn.setline(1, { 'foo', 'foo', 'foo', 'foo-bar' })
+    local function total(pat)
+      return fn.searchcount({ pattern = pat }).total
+    end
+    fn.cursor(1, 1)
+    eq(3, total([[foo\%>.l]]))
+    fn.cursor(3, 1)
+    eq(1, total([[foo\%>.l]]))
+    fn.cursor(1, 1)
+    eq(3, total([[foo\%>.l]]))
+
+    eq(1, total([[\<bar]]))
+    command('setlocal iskeyword+=-')
+    eq(0, total([[\<bar]]))
+
+    fn.setline(1, { 'a_b', 'a_b', 'a_b', 'a_b' })
+    eq(4, total([[\i\i\i]]))
+    command('set isident-=_')
+    eq(0, total([[\i\i\i]]))
+    eq(4, total([[\f\f\f]]))
+    command('set isfname-=_')
+    eq(0, total([[\f\f\f]]))
+  end)
 end)
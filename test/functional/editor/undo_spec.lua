@@ -227,6 +227,33 @@ describe(':undo! command', function()
   end)
 end)
 
+describe('undo memory', function()
+  before_each(clear)
+
+  it('is reported by nvim__buf_stats()', function()
+    local function stats()
+      return n.api.nvim__buf_stats(0)
+    end
+    eq(0, stats().undo_bytes)
+    eq(0, stats().undo_headers)
+
+    local line = ('x'):rep(1000)
+    n.api.nvim_buf_set_lines(0, 0, -1, true, fn['repeat']({ line }, 100))
+    command('let &undolevels = &undolevels')
+    command('%s/x/y/')
+    local st = stats()
+    eq(2, st.undo_headers)
+    -- The :s saved all 100 lines of 1000 bytes.
+    t.ok(st.undo_bytes > 100 * 1000)
+
+    feed('u')
+    command('1,10delete')
+    -- The :s branch is still there, next to the delete.
+    eq(3, stats().undo_headers)
+    t.ok(stats().undo_bytes > st.undo_bytes)
+  end)
+end)
+
 describe("opening file when 'undofile' is on", function()
   before_each(function()
     clear({ args = { '--cmd', 'set undofile' } })
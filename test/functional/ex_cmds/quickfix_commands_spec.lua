@@ -234,3 +234,49 @@ it(':vimgrep can specify Unicode pattern without delimiters', function()
     :vimgrep →^                              |
   ]])
 end)
+
+it(':vimgrep skipping files without a match finds the same matches', function()
+  local files = {
+    [file_base .. '_a'] = 'no match here\n',
+    [file_base .. '_b'] = 'one foobar\ntwo bazbar\n',
+    -- The match crosses the boundary of a 64 KiB block.
+    [file_base .. '_c'] = ('x'):rep(65534) .. 'foobar\n',
+    -- UTF-16 with BOM, the ASCII text is not in the bytes of the file.
+    [file_base .. '_d'] = '\255\254f\0o\0o\0b\0a\0r\0\n\0',
+  }
+  local names = {}
+  for name, text in pairs(files) do
+    write_file(name, text)
+    table.insert(names, name)
+  end
+  table.sort(names)
+  finally(function()
+    for _, name in ipairs(names) do
+      os.remove(name)
+    end
+  end)
+
+  local function grep(cmd)
+    command(cmd .. ' ' .. table.concat(names, ' '))
+    local res = {}
+    for _, item in ipairs(fn.getqflist()) do
+      table.insert(res, { fn.bufname(item.bufnr), item.lnum, item.col })
+    end
+    return res
+  end
+
+  local expected = {
+    { file_base .. '_b', 1, 5 },
+    { file_base .. '_b', 2, 5 },
+    { file_base .. '_c', 1, 65535 },
+    { file_base .. '_d', 1, 1 },
+  }
+  -- Without autocommands a file that can't match is not loaded in a buffer.
+  for _, cmd in ipairs({ 'noautocmd vimgrep /foobar\\|bazbar/j', 'vimgrep /foobar\\|bazbar/j' }) do
+    eq(expected, grep(cmd))
+  end
+  eq(
+    'Vim(vimgrep):E480: No match: nothing',
+    pcall_err(command, 'noautocmd vimgrep /nothing/j ' .. table.concat(names, ' '))
+  )
+end)
@@ -731,6 +731,34 @@ describe('quitting swapfile dialog on startup stops TUI properly', function()
 end)
 
 describe('swapfile', function()
+  it('keeps the text of hidden buffers only in the swapfile when idle', function()
+    local swapdir = 'Xtest_swap_hidden_dir'
+    local testfile = 'Xtest_swap_hidden_file'
+    mkdir(swapdir)
+    write_file(testfile, ('some text\n'):rep(20000))
+    finally(function()
+      rmdir(swapdir)
+      os.remove(testfile)
+    end)
+    clear()
+    exec(('set directory=%s// swapfile hidden'):format(swapdir))
+    command('edit ' .. testfile)
+    local bufnr = api.nvim_get_current_buf()
+    command('enew')
+    local used = api.nvim__stats().memfile_bytes
+    eq(0, api.nvim__stats().memfile_released)
+    command('set updatetime=1')
+    feed('h')
+    retry(nil, nil, function()
+      ok(api.nvim__stats().memfile_released > 0)
+    end)
+    ok(api.nvim__stats().memfile_bytes < used)
+    -- The text is read back from the swapfile.
+    local lines = api.nvim_buf_get_lines(bufnr, 0, -1, true)
+    eq(20000, #lines)
+    eq('some text', lines[12345])
+  end)
+
   it('when using device path #31606', function()
     t.skip(not is_os('win'), 'N/A: Windows feature')
     local cwd = vim.fs.normalize(vim.uv.cwd())
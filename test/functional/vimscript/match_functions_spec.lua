@@ -199,3 +199,47 @@ describe('matchaddpos()', function()
     )
   end)
 end)
+
+describe('match()', function()
+  it('reuses the compiled pattern', function()
+    local function stats()
+      return n.api.nvim__stats()
+    end
+    local hit = stats().regexp_cache_hit
+    local miss = stats().regexp_cache_miss
+    n.exec([[
+      let g:found = 0
+      for i in range(100)
+        let g:found += 'foo' .. i =~# 'o\d\+$' ? 1 : 0
+      endfor
+    ]])
+    eq(100, n.eval('g:found'))
+    eq(miss + 1, stats().regexp_cache_miss)
+    eq(hit + 99, stats().regexp_cache_hit)
+
+    -- Changing 'regexpengine' compiles again, results are the same.
+    command('set regexpengine=1')
+    eq(4, fn.match('abc foo', 'fo\\+'))
+    command('set regexpengine=2')
+    eq(4, fn.match('abc foo', 'fo\\+'))
+    eq(4, fn.match('abc foo', 'fo\\+'))
+    eq(miss + 3, stats().regexp_cache_miss)
+
+    -- "~" uses the last substitute string, it is compiled every time.
+    command('s/^/bar/')
+    eq(0, fn.match('bar', '~'))
+    command('s/^/baz/')
+    eq(0, fn.match('baz', '~'))
+  end)
+
+  it('does not reuse a pattern after the callback changed options', function()
+    -- The pattern is compiled without the 'l' flag, the callback adds it.
+    eq(
+      'x',
+      n.eval([[substitute("\t", '[\t]', '\=execute("set cpo+=l re=1") .. "x"', '')]])
+    )
+    command('set cpo-=l re=0')
+    eq(0, fn.match('\t', '[\\t]'))
+    eq(-1, fn.match('t', '[\\t]'))
+  end)
+end)
@@ -147,4 +147,26 @@ describe('multiqueue (multi-level event-queue)', function()
     eq('c3i1', get(child3))
     eq('c3i2', get(child3))
   end)
+
+  itp('keeps track of queued events', function()
+    local depth = ffi.new('size_t[1]')
+    local max_depth = ffi.new('size_t[1]')
+    local max_wait = ffi.new('uint64_t[1]')
+    local function stats(q)
+      multiqueue.multiqueue_stats(q, depth, max_depth, max_wait)
+      return { tonumber(depth[0]), tonumber(max_depth[0]) }
+    end
+
+    eq({ 9, 9 }, stats(parent))
+    eq({ 3, 3 }, stats(child1))
+    eq('c1i1', get(parent))
+    eq('c2i1', get(child2))
+    eq({ 7, 9 }, stats(parent))
+    eq({ 7, 7 }, stats(parent))
+    eq(0, tonumber(max_wait[0]))
+    eq({ 2, 3 }, stats(child1))
+    eq({ 3, 4 }, stats(child2))
+    free(child2)
+    eq({ 4, 7 }, stats(parent))
+  end)
 end)